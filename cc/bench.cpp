@@ -0,0 +1,175 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* monos-bench: runs the full pipeline repeatedly on every input and reports
+ * per phase the median, p95 and p99 over the runs as CSV, one line per input
+ * and phase. Every input is run in its own process, so its peak memory is
+ * its own and a failing input does not end the benchmark. */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "tools.h"
+#include "Config.h"
+#include "Monos.h"
+
+#ifndef MONOS_TEST_DATA
+#define MONOS_TEST_DATA "test-data"
+#endif
+
+static struct option bench_options[] = {
+		{ "help"        , no_argument      , 0, 'h'},
+		{ "runs"        , required_argument, 0, 'r'},
+		{ "warmup"      , required_argument, 0, 'w'},
+		{ 0, 0, 0, 0}
+};
+
+[[noreturn]]
+static void usage(const char *progname, int err) {
+	FILE *f = err ? stderr : stdout;
+
+	fprintf(f,"Usage: %s [options] [GRAPHML/MPOLY files or directories]\n", progname);
+	fprintf(f,"  Options: --runs <n> \t\t measured runs per input (default 10)\n");
+	fprintf(f,"           --warmup <n> \t unmeasured runs per input (default 1)\n");
+	fprintf(f,"\n");
+	fprintf(f,"Without inputs all .graphml and .mpoly files in %s are used.\n", MONOS_TEST_DATA);
+	fprintf(f,"Output: file,vertices,phase,runs,median,p95,p99,peak_rss_kb (seconds wall time)\n");
+	exit(err);
+}
+
+/* nearest rank percentile of sorted samples */
+static double percentile(const std::vector<double>& sorted, double p) {
+	if(sorted.empty()) {return 0.0;}
+	std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+	return sorted[std::max<std::size_t>(rank,1) - 1];
+}
+
+static void collectInputs(const std::string& path, std::vector<std::string>& inputs) {
+	namespace fs = std::filesystem;
+	if(fs::is_directory(path)) {
+		std::vector<std::string> files;
+		for(const auto& entry : fs::directory_iterator(path)) {
+			const auto ext = entry.path().extension();
+			if(ext == ".graphml" || ext == ".mpoly") {files.push_back(entry.path().string());}
+		}
+		std::sort(files.begin(),files.end());
+		inputs.insert(inputs.end(),files.begin(),files.end());
+	} else {
+		inputs.push_back(path);
+	}
+}
+
+/* one full run of monos, returns false if the run did not finish */
+static bool runOnce(const std::string& fileName, Timings& timings, unsigned long& vertices) {
+	Config config;
+	config.setNewInputfile(fileName);
+	config.outputFileName = "/dev/null";
+
+	Monos monos(config);
+	monos.run();
+	timings  = monos.timings;
+	vertices = (monos.data != nullptr) ? monos.data->getPolygon().size() : 0;
+	return monos.s != nullptr && monos.s->computationFinished;
+}
+
+static int benchInput(const std::string& fileName, int runs, int warmup) {
+	Timings timings;
+	unsigned long vertices = 0;
+
+	for(int i = 0; i < warmup; ++i) {
+		if(!runOnce(fileName,timings,vertices)) {return 1;}
+	}
+
+	const unsigned numPhases = static_cast<unsigned>(Phase::NUM_PHASES);
+	/* one row per phase, the last one for the whole run */
+	std::vector<std::vector<double>> samples(numPhases + 1);
+
+	for(int i = 0; i < runs; ++i) {
+		if(!runOnce(fileName,timings,vertices)) {return 1;}
+		for(unsigned p = 0; p < numPhases; ++p) {
+			samples[p].push_back(timings[static_cast<Phase>(p)].wall);
+		}
+		samples[numPhases].push_back(timings.sum(Phase::READ,Phase::WRITE).wall);
+	}
+
+	struct rusage usage;
+	long maxRSS = (getrusage(RUSAGE_SELF,&usage) == 0) ? usage.ru_maxrss : 0;
+
+	for(unsigned p = 0; p <= numPhases; ++p) {
+		auto& s = samples[p];
+		std::sort(s.begin(),s.end());
+		printf("%s,%lu,%s,%d,%.9g,%.9g,%.9g,%ld\n",
+				fileName.c_str(), vertices,
+				(p < numPhases) ? Timings::name(static_cast<Phase>(p)) : "total",
+				runs, percentile(s,50), percentile(s,95), percentile(s,99), maxRSS);
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[]) {
+	setupEasylogging(argc, argv);
+
+	int runs = 10, warmup = 1;
+	while (1) {
+		int option_index = 0;
+		int r = getopt_long(argc, argv, "h", bench_options, &option_index);
+		if (r == -1) break;
+		switch (r) {
+		case 'h': usage(argv[0], 0);
+		case 'r': runs   = std::max(1,atoi(optarg)); break;
+		case 'w': warmup = std::max(0,atoi(optarg)); break;
+		default:  usage(argv[0], 1);
+		}
+	}
+
+	std::vector<std::string> inputs;
+	for(int i = optind; i < argc; ++i) {collectInputs(argv[i],inputs);}
+	if(optind == argc) {collectInputs(MONOS_TEST_DATA,inputs);}
+
+	printf("file,vertices,phase,runs,median,p95,p99,peak_rss_kb\n");
+	fflush(stdout);
+
+	int failed = 0;
+	for(const auto& fileName : inputs) {
+		pid_t pid = fork();
+		if(pid == 0) {
+			int ret = benchInput(fileName,runs,warmup);
+			fflush(stdout);
+			_exit(ret);
+		}
+
+		int status = 0;
+		if(pid < 0 || waitpid(pid,&status,0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+			fprintf(stderr,"%s: failed\n",fileName.c_str());
+			++failed;
+		}
+	}
+
+	return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,420 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* monos-compare: runs monos and CGAL's general straight skeleton algorithm
+ * (create_interior_straight_skeleton_2) on the same inputs, compares both
+ * skeletons and reports the speedup of monos, one CSV line per input and
+ * CGAL kernel. monos runs with the kernel it was built with (see WITH_FP),
+ * CGAL with the exact predicates kernel with inexact (epick) and/or exact
+ * (epeck) constructions.
+ *
+ * Both skeletons are reduced to the same graph in doubles: nodes within
+ * 'eps' of each other are one node, zero-length arcs are dropped and nodes
+ * of degree two between the same pair of faces are skipped. An arc is then
+ * identified by its two end nodes and the two input edges whose faces it
+ * separates. The skeletons match if they have the same nodes and arcs; the
+ * largest difference of the times (offset distance) of a common node is
+ * reported as well. The exit code is 1 if any input does not match.
+ * With --export the skeleton of monos goes through exportStraightSkeleton
+ * and is read back like the one of CGAL. */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <getopt.h>
+
+#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
+#include <CGAL/Exact_predicates_exact_constructions_kernel.h>
+#include <CGAL/create_straight_skeleton_2.h>
+
+#include "tools.h"
+#include "Config.h"
+#include "Monos.h"
+#include "StraightSkeletonExport.h"
+
+using Epick = CGAL::Exact_predicates_inexact_constructions_kernel;
+using Epeck = CGAL::Exact_predicates_exact_constructions_kernel;
+
+static struct option compare_options[] = {
+		{ "help"        , no_argument      , 0, 'h'},
+		{ "kernel"      , required_argument, 0, 'k'},
+		{ "runs"        , required_argument, 0, 'r'},
+		{ "eps"         , required_argument, 0, 'e'},
+		{ "export"      , no_argument      , 0, 'x'},
+		{ 0, 0, 0, 0}
+};
+
+[[noreturn]]
+static void usage(const char *progname, int err) {
+	FILE *f = err ? stderr : stdout;
+
+	fprintf(f,"Usage: %s [options] <GRAPHML/MPOLY files or directories>\n", progname);
+	fprintf(f,"  Options: --kernel <k> \t CGAL kernel: epick, epeck or both (default)\n");
+	fprintf(f,"           --runs <n> \t\t timed runs per input and algorithm, the median is reported (default 1)\n");
+	fprintf(f,"           --eps <e> \t\t nodes closer than e times the bounding box diagonal are one (default 1e-9)\n");
+	fprintf(f,"           --export \t\t compare the skeleton of monos exported to a CGAL Straight_skeleton_2\n");
+	fprintf(f,"\n");
+	fprintf(f,"Inputs of growing size for the speedup are written by monos-gen.\n");
+	fprintf(f,"Output: file,vertices,kernel,monos,cgal,speedup,nodes,arcs,missing,extra,max_time_diff,result\n");
+	fprintf(f,"        (seconds wall time without reading and writing; missing/extra: arcs of CGAL not in\n");
+	fprintf(f,"        monos and vice versa, nodes and arcs are the counts of CGAL after the reduction)\n");
+	exit(err);
+}
+
+/* a straight skeleton in doubles, independent of kernel and algorithm */
+struct SkeletonGraph {
+	struct Node {
+		double x, y, time;
+	};
+	struct Arc {
+		ul a, b;
+		ul faceA, faceB;
+	};
+
+	std::vector<Node> nodes;
+	std::vector<Arc>  arcs;
+};
+
+static void collectInputs(const std::string& path, std::vector<std::string>& inputs) {
+	namespace fs = std::filesystem;
+	if(fs::is_directory(path)) {
+		std::vector<std::string> files;
+		for(const auto& entry : fs::directory_iterator(path)) {
+			const auto ext = entry.path().extension();
+			if(ext == ".graphml" || ext == ".mpoly") {files.push_back(entry.path().string());}
+		}
+		std::sort(files.begin(),files.end());
+		inputs.insert(inputs.end(),files.begin(),files.end());
+	} else {
+		inputs.push_back(path);
+	}
+}
+
+static double median(std::vector<double> samples) {
+	std::sort(samples.begin(),samples.end());
+	return samples[(samples.size() - 1) / 2];
+}
+
+/* the skeleton of the last run of monos, nodes and arcs as they are after
+ * the merge and the compaction */
+static SkeletonGraph fromMonos(const Monos& monos) {
+	SkeletonGraph g;
+	const Wavefront& wf = *monos.wf;
+	for(const auto& n : wf.nodes) {
+		g.nodes.push_back({CGAL::to_double(n.point.x()), CGAL::to_double(n.point.y()),
+			std::sqrt(CGAL::to_double(n.time))});
+	}
+	for(const auto& arc : wf.arcList) {
+		if(arc.isDisable() || arc.secondNodeIdx == MAX) {continue;}
+		g.arcs.push_back({arc.firstNodeIdx,arc.secondNodeIdx,arc.leftEdgeIdx,arc.rightEdgeIdx});
+	}
+	return g;
+}
+
+/* the skeleton of a CGAL straight skeleton; faces are numbered by the
+ * input edges, found by the vertices of their contour edge */
+template<class SS>
+static SkeletonGraph fromStraightSkeleton(const SS& ss, const BasicInput& input) {
+	std::map<std::pair<double,double>,ul> vertexIdx;
+	for(ul i = 0; i < input.vertices().size(); ++i) {
+		const auto& p = input.vertices()[i].p;
+		vertexIdx[{CGAL::to_double(p.x()),CGAL::to_double(p.y())}] = i;
+	}
+	std::map<std::pair<ul,ul>,ul> edgeIdx;
+	for(const auto& e : input.edges()) {
+		edgeIdx[{std::min(e.u,e.v),std::max(e.u,e.v)}] = e.id;
+	}
+
+	SkeletonGraph g;
+	std::unordered_map<int,ul> nodeIdx;
+	for(auto v = ss.vertices_begin(); v != ss.vertices_end(); ++v) {
+		nodeIdx[v->id()] = g.nodes.size();
+		g.nodes.push_back({CGAL::to_double(v->point().x()), CGAL::to_double(v->point().y()),
+			CGAL::to_double(v->time())});
+	}
+
+	/* the input edge of the face of a halfedge */
+	auto face = [&](const auto& h) -> ul {
+		const auto c = h->defining_contour_edge();
+		const auto& p = c->vertex()->point();
+		const auto& q = c->opposite()->vertex()->point();
+		ul u = vertexIdx[{CGAL::to_double(p.x()),CGAL::to_double(p.y())}];
+		ul v = vertexIdx[{CGAL::to_double(q.x()),CGAL::to_double(q.y())}];
+		return edgeIdx[{std::min(u,v),std::max(u,v)}];
+	};
+
+	for(auto h = ss.halfedges_begin(); h != ss.halfedges_end(); ++h) {
+		/* every bisector once */
+		if(!h->is_bisector() || h->id() > h->opposite()->id()) {continue;}
+		g.arcs.push_back({nodeIdx[h->vertex()->id()], nodeIdx[h->opposite()->vertex()->id()],
+			face(h), face(h->opposite())});
+	}
+	return g;
+}
+
+/* runs CGAL 'runs' times on the input polygon, returns the median time and
+ * the skeleton of the last run */
+template<class K>
+static SkeletonGraph fromCGAL(const BasicInput& input, int runs, double& seconds) {
+	using Point_2 = typename K::Point_2;
+
+	/* the polygon in the order of its edges, counter-clockwise */
+	std::vector<Point_2> contour;
+	for(const auto& e : input.edges()) {
+		const auto& p = input.vertices()[e.u].p;
+		contour.push_back(Point_2(CGAL::to_double(p.x()),CGAL::to_double(p.y())));
+	}
+
+	std::vector<double> samples;
+	decltype(CGAL::create_interior_straight_skeleton_2(contour.begin(),contour.end(),K())) ss;
+	for(int i = 0; i < runs; ++i) {
+		auto start = std::chrono::steady_clock::now();
+		ss = CGAL::create_interior_straight_skeleton_2(contour.begin(),contour.end(),K());
+		samples.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	}
+	seconds = median(samples);
+
+	if(!ss) {return SkeletonGraph();}
+	return fromStraightSkeleton(*ss,input);
+}
+
+/* nodes of both skeletons within eps are merged into one cluster */
+class Clusters {
+public:
+	Clusters(double eps) : eps(eps) {}
+
+	ul find(double x, double y) {
+		const long cx = static_cast<long>(std::floor(x / eps)), cy = static_cast<long>(std::floor(y / eps));
+		for(long dx = -1; dx <= 1; ++dx) {
+			for(long dy = -1; dy <= 1; ++dy) {
+				auto it = grid.find({cx + dx, cy + dy});
+				if(it == grid.end()) {continue;}
+				for(ul c : it->second) {
+					if(std::abs(points[c].first - x) <= eps && std::abs(points[c].second - y) <= eps) {return c;}
+				}
+			}
+		}
+		grid[{cx,cy}].push_back(points.size());
+		points.push_back({x,y});
+		return points.size() - 1;
+	}
+
+	ul size() const {return points.size();}
+
+private:
+	struct CellHash {
+		std::size_t operator()(const std::pair<long,long>& c) const {
+			return std::hash<long>()(c.first) * 31 + std::hash<long>()(c.second);
+		}
+	};
+
+	double eps;
+	std::vector<std::pair<double,double>> points;
+	std::unordered_map<std::pair<long,long>,std::vector<ul>,CellHash> grid;
+};
+
+using ArcKey = std::tuple<ul,ul,ul,ul>;
+
+/* the arcs of g between clusters, see the reduction at the top */
+static std::vector<ArcKey> reduce(const SkeletonGraph& g, Clusters& clusters,
+		std::vector<double>& clusterTime) {
+	std::vector<ul> cluster;
+	for(const auto& n : g.nodes) {
+		const ul c = clusters.find(n.x,n.y);
+		if(c >= clusterTime.size()) {clusterTime.resize(c + 1,-1.0);}
+		clusterTime[c] = std::max(clusterTime[c],n.time);
+		cluster.push_back(c);
+	}
+
+	std::vector<ArcKey> arcs;
+	for(const auto& arc : g.arcs) {
+		const ul a = cluster[arc.a], b = cluster[arc.b];
+		if(a == b) {continue;}
+		arcs.emplace_back(a,b,std::min(arc.faceA,arc.faceB),std::max(arc.faceA,arc.faceB));
+	}
+
+	/* skip nodes of degree two between the same pair of faces */
+	std::vector<std::vector<ul>> incident(clusters.size());
+	for(ul i = 0; i < arcs.size(); ++i) {
+		incident[std::get<0>(arcs[i])].push_back(i);
+		incident[std::get<1>(arcs[i])].push_back(i);
+	}
+	std::vector<bool> alive(arcs.size(),true);
+	for(ul c = 0; c < incident.size(); ++c) {
+		if(incident[c].size() != 2) {continue;}
+		const ul i = incident[c][0], j = incident[c][1];
+		if(i == j || std::get<2>(arcs[i]) != std::get<2>(arcs[j]) || std::get<3>(arcs[i]) != std::get<3>(arcs[j])) {continue;}
+		const ul a = (std::get<0>(arcs[i]) == c) ? std::get<1>(arcs[i]) : std::get<0>(arcs[i]);
+		const ul b = (std::get<0>(arcs[j]) == c) ? std::get<1>(arcs[j]) : std::get<0>(arcs[j]);
+		if(a == b) {continue;}
+		std::get<0>(arcs[i]) = a;
+		std::get<1>(arcs[i]) = b;
+		std::replace(incident[b].begin(),incident[b].end(),j,i);
+		incident[c].clear();
+		alive[j] = false;
+	}
+
+	std::vector<ArcKey> result;
+	for(ul i = 0; i < arcs.size(); ++i) {
+		if(!alive[i]) {continue;}
+		auto key = arcs[i];
+		if(std::get<0>(key) > std::get<1>(key)) {std::swap(std::get<0>(key),std::get<1>(key));}
+		result.push_back(key);
+	}
+	std::sort(result.begin(),result.end());
+	return result;
+}
+
+struct Comparison {
+	ul nodes = 0, arcs = 0, missing = 0, extra = 0;
+	double maxTimeDiff = 0.0;
+	bool match() const {return missing == 0 && extra == 0;}
+};
+
+static Comparison compare(const SkeletonGraph& mon, const SkeletonGraph& cgal, double eps) {
+	Clusters clusters(eps);
+	std::vector<double> monTime, cgalTime;
+	auto monArcs  = reduce(mon,clusters,monTime);
+	auto cgalArcs = reduce(cgal,clusters,cgalTime);
+
+	Comparison c;
+	std::vector<ArcKey> diff;
+	std::set_difference(cgalArcs.begin(),cgalArcs.end(),monArcs.begin(),monArcs.end(),std::back_inserter(diff));
+	c.missing = diff.size();
+	diff.clear();
+	std::set_difference(monArcs.begin(),monArcs.end(),cgalArcs.begin(),cgalArcs.end(),std::back_inserter(diff));
+	c.extra = diff.size();
+
+	c.arcs = cgalArcs.size();
+	std::vector<ul> nodes;
+	for(const auto& arc : cgalArcs) {
+		nodes.push_back(std::get<0>(arc));
+		nodes.push_back(std::get<1>(arc));
+	}
+	std::sort(nodes.begin(),nodes.end());
+	c.nodes = std::unique(nodes.begin(),nodes.end()) - nodes.begin();
+
+	for(ul i = 0; i < std::min(monTime.size(),cgalTime.size()); ++i) {
+		if(monTime[i] >= 0.0 && cgalTime[i] >= 0.0) {
+			c.maxTimeDiff = std::max(c.maxTimeDiff,std::abs(monTime[i] - cgalTime[i]));
+		}
+	}
+	return c;
+}
+
+/* returns false if the input does not match for some kernel or fails */
+static bool compareInput(const std::string& fileName, bool epick, bool epeck, int runs, double eps, bool exported) {
+	Config config;
+	config.setNewInputfile(fileName);
+	config.outputFileName = "/dev/null";
+
+	/* the last run is kept, its skeleton and input are compared */
+	std::vector<double> samples;
+	std::unique_ptr<Monos> monos;
+	for(int i = 0; i < runs; ++i) {
+		monos.reset();
+		monos = std::make_unique<Monos>(config);
+		monos->run();
+		if(monos->s == nullptr || !monos->s->computationFinished) {
+			fprintf(stderr,"%s: monos failed\n",fileName.c_str());
+			return false;
+		}
+		samples.push_back(monos->timings.sum(Phase::DECOMPOSE,Phase::COMPACTION).wall);
+	}
+	const double monosTime = median(samples);
+	const BasicInput& input = monos->input;
+	/* the export is read back like a skeleton of CGAL, see StraightSkeletonExport.h */
+	const SkeletonGraph mon = (exported)
+		? fromStraightSkeleton(*exportStraightSkeleton<CGAL::Straight_skeleton_2<Epick>>(*monos->wf),input)
+		: fromMonos(*monos);
+	const auto& box = *monos->data->bbox;
+	const double diagonal = std::hypot(CGAL::to_double(box.xMax.p.x() - box.xMin.p.x()),
+									   CGAL::to_double(box.yMax.p.y() - box.yMin.p.y()));
+
+	bool ok = true;
+	auto report = [&](const char* kernel, const SkeletonGraph& cgal, double cgalTime) {
+		const Comparison c = compare(mon,cgal,eps * diagonal);
+		printf("%s,%lu,%s,%.9g,%.9g,%.3f,%lu,%lu,%lu,%lu,%.9g,%s\n",
+				fileName.c_str(), static_cast<unsigned long>(input.vertices().size()), kernel,
+				monosTime, cgalTime, (monosTime > 0.0) ? cgalTime / monosTime : 0.0,
+				c.nodes, c.arcs, c.missing, c.extra, c.maxTimeDiff, c.match() ? "match" : "MISMATCH");
+		fflush(stdout);
+		ok = ok && c.match();
+	};
+
+	double cgalTime = 0.0;
+	if(epick) {
+		auto cgal = fromCGAL<Epick>(input,runs,cgalTime);
+		report("epick",cgal,cgalTime);
+	}
+	if(epeck) {
+		auto cgal = fromCGAL<Epeck>(input,runs,cgalTime);
+		report("epeck",cgal,cgalTime);
+	}
+	return ok;
+}
+
+int main(int argc, char *argv[]) {
+	setupEasylogging(argc, argv);
+
+	bool epick = true, epeck = true, exported = false;
+	int runs = 1;
+	double eps = 1e-9;
+	while (1) {
+		int option_index = 0;
+		int r = getopt_long(argc, argv, "h", compare_options, &option_index);
+		if (r == -1) break;
+		switch (r) {
+		case 'h': usage(argv[0], 0);
+		case 'k': {
+			const std::string kernel(optarg);
+			if(kernel != "epick" && kernel != "epeck" && kernel != "both") {usage(argv[0], 1);}
+			epick = (kernel != "epeck");
+			epeck = (kernel != "epick");
+			break;
+		}
+		case 'r': runs = std::max(1,atoi(optarg)); break;
+		case 'e': eps  = atof(optarg); break;
+		case 'x': exported = true; break;
+		default:  usage(argv[0], 1);
+		}
+	}
+	if(optind == argc) {usage(argv[0], 1);}
+
+	std::vector<std::string> inputs;
+	for(int i = optind; i < argc; ++i) {collectInputs(argv[i],inputs);}
+
+	printf("file,vertices,kernel,monos,cgal,speedup,nodes,arcs,missing,extra,max_time_diff,result\n");
+	fflush(stdout);
+
+	bool ok = true;
+	for(const auto& fileName : inputs) {
+		ok = compareInput(fileName,epick,epeck,runs,eps,exported) && ok;
+	}
+	return ok ? 0 : 1;
+}
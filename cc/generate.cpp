@@ -0,0 +1,294 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* monos-gen: writes random x-monotone polygons of a given size for scaling
+ * experiments, as GraphML or, for sizes where parsing GraphML dominates, in
+ * the binary polygon format of PolygonFile.h (chosen by the extension .mpoly).
+ * Coordinates are integers, hence exact in every kernel, and the polygon is
+ * streamed vertex by vertex, so 10^8 vertices need no memory to speak of.
+ *
+ * All families are x-monotone by construction: the lower chain lies below and
+ * the upper chain above y = 0, and the vertices of each chain are placed in
+ * their own slot of the x range, one slot per vertex. */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include <getopt.h>
+
+#include "PolygonFile.h"
+
+enum class Family {UNIFORM, RECTI, CONVEX, COMB, DEGENERATE};
+
+static const char* familyNames[] = {"uniform", "recti", "convex", "comb", "degenerate"};
+
+static struct option gen_options[] = {
+		{ "help"        , no_argument      , 0, 'h'},
+		{ "family"      , required_argument, 0, 'f'},
+		{ "vertices"    , required_argument, 0, 'n'},
+		{ "seed"        , required_argument, 0, 's'},
+		{ "out"         , required_argument, 0, 'o'},
+		{ 0, 0, 0, 0}
+};
+
+[[noreturn]]
+static void usage(const char *progname, int err) {
+	FILE *f = err ? stderr : stdout;
+
+	fprintf(f,"Usage: %s [options] --out <filename>\n", progname);
+	fprintf(f,"  Options: --family <name> \t uniform (default), recti, convex, comb or degenerate\n");
+	fprintf(f,"           --vertices <n> \t number of vertices (default 1000)\n");
+	fprintf(f,"           --seed <n> \t\t seed of the random generator (default 1)\n");
+	fprintf(f,"           --out <filename> \t .mpoly writes the binary format, anything else GraphML\n");
+	fprintf(f,"\n");
+	fprintf(f,"  uniform:    random heights above and below the x-axis\n");
+	fprintf(f,"  recti:      rectilinear, random steps (rounded to a multiple of 4 vertices)\n");
+	fprintf(f,"  convex:     an ellipse with small random dents\n");
+	fprintf(f,"  comb:       deep teeth on both chains, mostly reflex vertices\n");
+	fprintf(f,"  degenerate: runs of collinear edges, both chains mirror images of each\n");
+	fprintf(f,"              other on a regular grid, many simultaneous events (even size)\n");
+	exit(err);
+}
+
+/* streams the vertices, in counter-clockwise order, to the output file */
+class Output {
+public:
+	Output(FILE* f, bool binary, uint64_t numVertices) : f(f), binary(binary), numVertices(numVertices) {
+		if(binary) {
+			const polygonfile::Header header = polygonfile::makeHeader(numVertices);
+			fwrite(&header,sizeof(header),1,f);
+		} else {
+			fprintf(f,"<graphml xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" xmlns=\"http://graphml.graphdrawing.org/xmlns\" xsi:schemaLocation=\"http://graphml.graphdrawing.org/xmlns http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd\">\n");
+			fprintf(f,"  <!-- Created by monos-gen -->\n");
+			fprintf(f,"  <key attr.name=\"vertex-coordinate-x\" attr.type=\"string\" for=\"node\" id=\"x\"/>\n");
+			fprintf(f,"  <key attr.name=\"vertex-coordinate-y\" attr.type=\"string\" for=\"node\" id=\"y\"/>\n");
+			fprintf(f,"  <key attr.name=\"edge-weight\" attr.type=\"string\" for=\"edge\" id=\"w\">\n");
+			fprintf(f,"    <default>1.0</default>\n");
+			fprintf(f,"  </key>\n");
+			fprintf(f,"  <key attr.name=\"edge-weight-additive\" attr.type=\"string\" for=\"edge\" id=\"wa\">\n");
+			fprintf(f,"    <default>0.0</default>\n");
+			fprintf(f,"  </key>\n");
+			fprintf(f,"  <graph edgedefault=\"undirected\">\n");
+		}
+	}
+
+	inline void vertex(int64_t x, int64_t y) {
+		if(binary) {
+			const double p[2] = {static_cast<double>(x), static_cast<double>(y)};
+			fwrite(p,sizeof(p),1,f);
+		} else {
+			fprintf(f,"    <node id=\"%llu\">\n      <data key=\"x\">%lld</data>\n      <data key=\"y\">%lld</data>\n    </node>\n",
+					static_cast<unsigned long long>(written), static_cast<long long>(x), static_cast<long long>(y));
+		}
+		++written;
+	}
+
+	/* returns false if the number of vertices does not match the header */
+	bool finish() {
+		if(!binary) {
+			for(uint64_t i = 0; i < written; ++i) {
+				fprintf(f,"    <edge source=\"%llu\" target=\"%llu\"/>\n",
+						static_cast<unsigned long long>(i), static_cast<unsigned long long>((i + 1) % written));
+			}
+			fprintf(f,"  </graph>\n</graphml>\n");
+		}
+		return written == numVertices && !ferror(f);
+	}
+
+private:
+	FILE* f;
+	bool binary;
+	uint64_t numVertices;
+	uint64_t written = 0;
+};
+
+class Generator {
+public:
+	Generator(Family family, uint64_t seed) : family(family), rng(seed) {}
+
+	/* the number of vertices actually generated for a requested size */
+	uint64_t numVertices(uint64_t n) const {
+		n = std::max<uint64_t>(n,4);
+		switch(family) {
+		case Family::RECTI:      return std::max<uint64_t>(n / 4 * 4, 4);
+		case Family::DEGENERATE: return n + (n % 2);
+		case Family::UNIFORM:
+		case Family::CONVEX:
+		case Family::COMB:       break;
+		}
+		return n;
+	}
+
+	void generate(uint64_t n, Output& out) {
+		if(family == Family::RECTI) {
+			generateRecti(n,out);
+			return;
+		}
+
+		/* leftmost vertex, lower chain, rightmost vertex, upper chain */
+		const uint64_t nl = (n - 2) / 2, nu = n - 2 - nl;
+		const int64_t X  = 16 * static_cast<int64_t>(std::max(nl,nu) + 1);
+		const int64_t Y  = X / 4;
+		const int64_t wl = X / static_cast<int64_t>(nl + 1);
+		const int64_t wu = X / static_cast<int64_t>(nu + 1);
+
+		out.vertex(0,0);
+		for(uint64_t i = 0; i < nl; ++i) {
+			const int64_t x = static_cast<int64_t>(i + 1) * wl + jitter(wl);
+			out.vertex(x,-height(i,x,X,Y));
+		}
+		out.vertex(X,0);
+		for(uint64_t j = 0; j < nu; ++j) {
+			const int64_t x = X - static_cast<int64_t>(j + 1) * wu + jitter(wu);
+			/* the upper chain runs right to left, the degenerate family mirrors
+			 * the lower chain, the index of its counterpart is used for that */
+			out.vertex(x,height(nu - 1 - j,x,X,Y));
+		}
+	}
+
+private:
+	Family family;
+	std::mt19937_64 rng;
+
+	inline int64_t uniform(int64_t lo, int64_t hi) {
+		return std::uniform_int_distribution<int64_t>(lo,hi)(rng);
+	}
+
+	/* offset within the slot of width w, consecutive vertices stay at least
+	 * two units apart; none on the regular grid of the degenerate family */
+	inline int64_t jitter(int64_t w) {
+		if(family == Family::DEGENERATE) {return 0;}
+		const int64_t r = w / 2 - 1;
+		return uniform(-r,r);
+	}
+
+	/* distance of the i-th vertex of a chain from the x-axis, always > 0 */
+	int64_t height(uint64_t i, int64_t x, int64_t X, int64_t Y) {
+		switch(family) {
+		case Family::CONVEX: {
+			const double t = 2.0 * static_cast<double>(x) / static_cast<double>(X) - 1.0;
+			return 1 + std::llround(Y * std::sqrt(std::max(0.0,1.0 - t * t))) + uniform(0,2);
+		}
+		case Family::COMB:
+			return (i % 2 == 0) ? Y - uniform(0,Y / 16) : 1 + uniform(0,Y / 16);
+		case Family::DEGENERATE:
+			/* runs of three vertices at the same height, i.e., collinear edges */
+			return ((i / 3) % 2 == 0) ? Y / 2 : Y;
+		case Family::UNIFORM:
+		case Family::RECTI:
+			break;
+		}
+		return uniform(1,Y);
+	}
+
+	/* a staircase below and one above the x-axis, both with K levels; the
+	 * polygon starts at the top left corner and goes down the left side */
+	void generateRecti(uint64_t n, Output& out) {
+		const uint64_t K = n / 4;
+		const int64_t X  = 16 * static_cast<int64_t>(K);
+		const int64_t Y  = X / 4;
+		const int64_t w  = X / static_cast<int64_t>(K);
+
+		/* a new level, different from the current one and the excluded one */
+		auto level = [&](int64_t current, int64_t excluded) {
+			int64_t l;
+			do {l = uniform(1,Y);} while(l == current || l == excluded);
+			return l;
+		};
+
+		const int64_t u0 = uniform(1,Y);
+		int64_t l = uniform(1,Y);
+		out.vertex(0,u0);
+		out.vertex(0,-l);
+		for(uint64_t k = 1; k < K; ++k) {
+			const int64_t x = static_cast<int64_t>(k) * w + jitter(w);
+			const int64_t next = level(l,0);
+			out.vertex(x,-l);
+			out.vertex(x,-next);
+			l = next;
+		}
+
+		/* the upper chain is built right to left and has to end at level u0 */
+		int64_t u = (K > 1) ? level(u0,0) : u0;
+		out.vertex(X,-l);
+		out.vertex(X,u);
+		for(uint64_t k = K - 1; k >= 1; --k) {
+			const int64_t x = static_cast<int64_t>(k) * w + jitter(w);
+			const int64_t next = (k == 1) ? u0 : level(u,u0);
+			out.vertex(x,u);
+			out.vertex(x,next);
+			u = next;
+		}
+	}
+};
+
+int main(int argc, char *argv[]) {
+	Family family = Family::UNIFORM;
+	uint64_t n = 1000, seed = 1;
+	std::string fileName;
+
+	while (1) {
+		int option_index = 0;
+		int r = getopt_long(argc, argv, "h", gen_options, &option_index);
+		if (r == -1) break;
+		switch (r) {
+		case 'h': usage(argv[0], 0);
+		case 'f': {
+			auto it = std::find_if(std::begin(familyNames),std::end(familyNames),
+					[](const char* name) {return strcmp(name,optarg) == 0;});
+			if(it == std::end(familyNames)) {usage(argv[0], 1);}
+			family = static_cast<Family>(it - std::begin(familyNames));
+			break;
+		}
+		case 'n': n = strtoull(optarg,nullptr,10); break;
+		case 's': seed = strtoull(optarg,nullptr,10); break;
+		case 'o': fileName = optarg; break;
+		default:  usage(argv[0], 1);
+		}
+	}
+	if(fileName.empty() || optind != argc) {usage(argv[0], 1);}
+
+	const bool binary = fileName.size() >= 6 && fileName.compare(fileName.size() - 6,6,".mpoly") == 0;
+	FILE* f = fopen(fileName.c_str(), binary ? "wb" : "w");
+	if(f == nullptr) {
+		fprintf(stderr,"cannot open %s\n",fileName.c_str());
+		return 1;
+	}
+	/* a large buffer, the output is written in small pieces */
+	static char buffer[1 << 20];
+	setvbuf(f,buffer,_IOFBF,sizeof(buffer));
+
+	Generator generator(family,seed);
+	const uint64_t numVertices = generator.numVertices(n);
+	Output out(f,binary,numVertices);
+	generator.generate(numVertices,out);
+
+	const bool ok = out.finish();
+	if(fclose(f) != 0 || !ok) {
+		fprintf(stderr,"writing %s failed\n",fileName.c_str());
+		return 1;
+	}
+	return 0;
+}
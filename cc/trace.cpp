@@ -0,0 +1,67 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* decodes a trace dump of monos (see --dump-trace and TRACE_CATEGORIES) into
+ * one line per record: time [ns], category, event, a, b, value */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "Trace.h"
+
+static const char* categoryName(uint16_t category) {
+	switch(category) {
+	case trace::INPUT:  return "input";
+	case trace::EVENTS: return "events";
+	case trace::HEAP:   return "heap";
+	case trace::MERGE:  return "merge";
+	case trace::OUTPUT: return "output";
+	default:            return "?";
+	}
+}
+
+int main(int argc, char *argv[]) {
+	if(argc != 2) {
+		std::cerr << "Usage: " << argv[0] << " <trace file>" << std::endl;
+		return 1;
+	}
+
+	std::ifstream in(argv[1],std::ifstream::binary);
+	trace::Header header;
+	if(!in.read(reinterpret_cast<char*>(&header),sizeof(header))
+		|| std::memcmp(header.magic,"MONOSTRC",8) != 0
+		|| header.recordSize != sizeof(trace::Record)) {
+		std::cerr << argv[1] << " is not a monos trace" << std::endl;
+		return 1;
+	}
+
+	if(header.recorded > header.stored) {
+		std::cout << "# " << header.recorded - header.stored << " older records were overwritten\n";
+	}
+
+	trace::Record r;
+	while(in.read(reinterpret_cast<char*>(&r),sizeof(r))) {
+		std::cout << r.ns << " " << categoryName(r.category) << " "
+				  << ((r.id < trace::NUM_IDS) ? trace::idNames[r.id] : "?") << " "
+				  << r.a << " " << r.b << " " << r.value << "\n";
+	}
+
+	return 0;
+}
@@ -25,10 +25,11 @@
 #include "cgTypes.h"
 
 ArcGraphicsItem::
-ArcGraphicsItem(const Nodes * const nodes, const ArcList * arcs)
+ArcGraphicsItem(const Wavefront * const wf)
   : Base()
-  , nodes(nodes)
-  , arcs(arcs)
+  , wf(wf)
+  , nodes(&wf->nodes)
+  , arcs(&wf->arcList)
   , painterostream(0)
   , vertices_pen(QPen(::Qt::blue, 3))
   , segments_pen(QPen(::Qt::blue, 0, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin))
@@ -62,7 +63,7 @@ paint(QPainter *painter, const QStyleOptionGraphicsItem * /*option*/, QWidget *
 	painter->setPen(segmentsPen());
 	for (const auto& e : *arcs) {
 		if(e.type != ArcType::DISABLED) {
-			painterostream << e;
+			painterostream << wf->getArcSegment(e);
 		}
 	}
 
@@ -89,7 +90,7 @@ paint(QPainter *painter, const QStyleOptionGraphicsItem * /*option*/, QWidget *
 		painter->setFont(font);
 		for (auto e = arcs->begin(); e != arcs->end(); ++e) {
 			if(e->type != ArcType::DISABLED) {
-				QPointF p(transform.map(convert( CGAL::midpoint(e->source(), e->target()) )));
+				QPointF p(transform.map(convert( CGAL::midpoint(wf->getArcSource(*e), wf->getArcTarget(*e)) )));
 
 				/* to avoid multiple overlaying labels */
 				std::srand(e->id);
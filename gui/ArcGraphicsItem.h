@@ -34,6 +34,7 @@ class ArcGraphicsItem :
     using Base = CGAL::Qt::GraphicsItem;
 
   private:
+    const Wavefront * const wf;
     const Nodes * const nodes;
     const ArcList * const arcs;
     CGAL::Qt::PainterOstream<K> painterostream;
@@ -53,7 +54,7 @@ class ArcGraphicsItem :
     void updateBoundingBox();
 
   public:
-    ArcGraphicsItem(const Nodes * const nodes, const ArcList * arcs);
+    ArcGraphicsItem(const Wavefront * const wf);
 
     QRectF boundingRect() const { return bounding_rect; };
     void setBoundingRect(const QRectF& br) {bounding_rect = br;}
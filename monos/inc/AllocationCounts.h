@@ -0,0 +1,47 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALLOCATIONCOUNTS_H_
+#define ALLOCATIONCOUNTS_H_
+
+/* set by cmake (COUNT_ALLOCATIONS), replaces the global operator new and
+ * delete by counting versions, see AllocationCounts.cpp; without it the
+ * counters stay zero and the allocator is the one of the standard library */
+#ifndef MONOS_COUNT_ALLOCATIONS
+#define MONOS_COUNT_ALLOCATIONS 0
+#endif
+
+namespace allocation {
+
+struct Counts {
+	unsigned long allocations = 0;
+	unsigned long bytes       = 0;	/* requested, over all allocations */
+	unsigned long frees       = 0;
+};
+
+constexpr bool enabled() {return MONOS_COUNT_ALLOCATIONS != 0;}
+
+/* since the start of the process; the timings charge the difference
+ * between entering and leaving to the phase. Not synchronized, monos
+ * allocates from a single thread */
+extern Counts counts;
+
+}
+
+#endif /* ALLOCATIONCOUNTS_H_ */
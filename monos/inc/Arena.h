@@ -0,0 +1,92 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <cstddef>
+#include <memory_resource>
+
+/* counts the (large) blocks the arena requests from the system */
+class CountingResource : public std::pmr::memory_resource {
+public:
+	std::size_t allocations = 0;
+	std::size_t bytes       = 0;
+
+private:
+	void* do_allocate(std::size_t size, std::size_t alignment) override {
+		++allocations;
+		bytes += size;
+		return std::pmr::new_delete_resource()->allocate(size,alignment);
+	}
+	void do_deallocate(void* p, std::size_t size, std::size_t alignment) override {
+		std::pmr::new_delete_resource()->deallocate(p,size,alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+};
+
+/* one arena per run of monos: every container of the wavefront, the event
+ * queue and the skeleton allocates from here and nothing is freed before
+ * the arena itself is released, which happens in one step at teardown.
+ * The initial buffer is sized from the input and may be backed by huge pages */
+class Arena : public std::pmr::memory_resource {
+public:
+	Arena(std::size_t initialSize, bool hugePages = false);
+	~Arena();
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	/* release all memory at once, returns the time it took in seconds */
+	double release();
+
+	std::size_t allocations = 0;
+	std::size_t bytes       = 0;
+
+	inline std::size_t systemAllocations() const {return upstream.allocations;}
+	inline std::size_t systemBytes() const {return buffer.size + upstream.bytes;}
+	inline bool usesHugePages() const {return buffer.hugePages;}
+
+private:
+	void* do_allocate(std::size_t size, std::size_t alignment) override {
+		++allocations;
+		bytes += size;
+		return pool.allocate(size,alignment);
+	}
+	/* monotonic: memory is given back by release() only */
+	void do_deallocate(void*, std::size_t, std::size_t) override {}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+	struct Buffer {
+		void* data;
+		std::size_t size;
+		bool hugePages;
+	};
+	static Buffer mapBuffer(std::size_t size, bool hugePages);
+
+	Buffer buffer;
+	CountingResource upstream;
+	std::pmr::monotonic_buffer_resource pool;
+};
+
+#endif /* ARENA_H_ */
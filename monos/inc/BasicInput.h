@@ -25,6 +25,7 @@
 #include "BGLGraph.h"
 #include "tools.h"
 
+#include <istream>
 #include <utility>
 
 
@@ -35,6 +36,12 @@ private:
 	VertexList vertices_;
 	EdgeList edges_;
 
+	/* edge table, structure of arrays indexed by the edge id: the exact
+	 * supporting line of each edge and its coefficients in doubles, the
+	 * latter normalized such that a*x + b*y + c is the signed distance */
+	std::vector<Line>   lines_;
+	std::vector<double> line_a_, line_b_, line_c_;
+
 	/** Add an input vertex to the vertexlist */
 	inline void add_vertex(Vertex&& p) {
 		vertices_.emplace_back(std::forward<Vertex>(p));
@@ -44,15 +51,20 @@ private:
 		assert(u < vertices_.size());
 		assert(v < vertices_.size());
 		assert(u!=v);
-		edges_.emplace_back(Edge(u,v,edges_.size(), Segment(vertices_[u].p, vertices_[v].p)));
+		edges_.emplace_back(Edge(u,v,edges_.size()));
+		add_line(vertices_[u].p, vertices_[v].p);
 
 		sort_tuple(u,v);
 	}
 
+	void add_line(const Point& a, const Point& b);
+
 public:
 	const VertexList& vertices() const { return vertices_; };
 	const EdgeList& edges() const { return edges_; };
 	void add_graph(const BGLGraph& graph);
+	/** read a polygon in the binary format of PolygonFile.h */
+	bool add_polygon(std::istream& in);
 	unsigned get_num_of_deg1_vertices() const {
 		return num_of_deg1_vertices;
 	}
@@ -67,7 +79,16 @@ public:
 		assert(idx < edges_.size());
 		return edges_[idx];
 	}
-	const Segment& get_segment(const Edge& e) const {
-		return e.segment;
+	Segment get_segment(const Edge& e) const {
+		return Segment(vertices_[e.u].p, vertices_[e.v].p);
+	}
+	const Line& get_line(unsigned idx) const {
+		assert(idx < lines_.size());
+		return lines_[idx];
+	}
+	/** signed distance of (x,y) to the supporting line of edge idx in doubles,
+	 * positive on the interior (left) side of the edge */
+	inline double signed_distance(unsigned idx, double x, double y) const {
+		return line_a_[idx] * x + line_b_[idx] * y + line_c_[idx];
 	}
 };
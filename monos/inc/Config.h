@@ -23,6 +23,7 @@
 
 #include <string>
 #include <list>
+#include <vector>
 #include <fstream>
 
 #include <ctime>
@@ -40,6 +41,17 @@ static struct option long_options[] = {
 		{ "normalize"   , no_argument      , 0, 'n'},
 		{ "timings"     , no_argument      , 0, 't'},
 		{ "out"         , required_argument, 0, 'o'},
+		{ "hugepages"   , no_argument      , 0, 'p'},
+		{ "dump-trace"  , required_argument, 0, 'r'},
+		{ "report"      , required_argument, 0, 'j'},
+		{ "perf"        , no_argument      , 0, 'c'},
+		{ "max-time"    , required_argument, 0, 'm'},
+		{ "insets"      , required_argument, 0, 'f'},
+		{ "locate"      , required_argument, 0, 'l'},
+		{ "raster"      , required_argument, 0, 'g'},
+		{ "profile"     , no_argument      , 0, 'a'},
+		{ "binary"      , no_argument      , 0, 'b'},
+		{ "exact"       , no_argument      , 0, 'e'},
 		{ 0, 0, 0, 0}
 };
 
@@ -57,8 +69,19 @@ public:
 		fprintf(f,"           --mon \t| --x \t\t\t monotone but not x-monotone (works by default in master branch)\n");
 		fprintf(f,"           --timings \t| --t \t\t\t print timings [ms]\n");
 		fprintf(f,"           --normalize \t| --n \t\t\t write output normalized to the origin\n");
+		fprintf(f,"           --hugepages \t back the per-run arena by huge pages if available\n");
+		fprintf(f,"           --dump-trace <filename> \t dump the trace ring buffer (see TRACE_CATEGORIES)\n");
+		fprintf(f,"           --report <filename> \t write time and memory per phase as JSON ('-' for stdout)\n");
+		fprintf(f,"           --perf \t add hardware counters per phase to the report (Linux, if permitted)\n");
+		fprintf(f,"           --max-time <offset> \t stop the wavefront at this offset, write the skeleton below it and the fronts\n");
+		fprintf(f,"           --insets <d1,d2,...> \t write the offset polygons at these distances to <out>-offsets.obj\n");
+		fprintf(f,"           --locate <filename> \t for every 'x y' line the face (edge, -1 outside) and the height to <out>-located.txt\n");
+		fprintf(f,"           --raster <w>x<h> \t write the roof heights on a w x h grid to <out>-height.pfm\n");
+		fprintf(f,"           --profile \t write area and perimeter over the offset and the roof volume to <out>-profile.txt\n");
+		fprintf(f,"           --binary \t| --b \t\t\t write the skeleton in the binary format of SkeletonFile.h to <out>.mskl\n");
+		fprintf(f,"           --exact \t| --e \t\t\t with --binary, the numbers of the kernel as text to <out>-exact.txt\n");
 		fprintf(f,"\n");
-		fprintf(f,"Input format is .gml/.graphml (GraphML).\n");
+		fprintf(f,"Input format is .gml/.graphml (GraphML) or the binary polygon format of monos-gen.\n");
 		fprintf(f,"Parsing input from cin assumes graphml format.\n");
 		fprintf(f,"\n");
 		exit(err);
@@ -95,6 +118,20 @@ public:
 	bool 			normalize = false;
 	bool 			timings   = false;
 	bool			not_x_mon = false;
+	bool			hugePages = false;
+	bool			perfCounters = false;
+	/* offset at which the wavefront stops, 0 for the complete skeleton */
+	double			maxOffset = 0.0;
+	/* distances of the offset polygons to extract, ascending */
+	std::vector<double> offsets;
+	/* size of the height map, 0 for none */
+	unsigned		rasterWidth  = 0;
+	unsigned		rasterHeight = 0;
+	/* area, perimeter and volume as piecewise polynomials of the offset */
+	bool			profile   = false;
+	/* the skeleton in the binary format, optionally with the exact numbers */
+	bool			binary    = false;
+	bool			exact     = false;
 
 	bool			duplicate = false;
 	int				copies	  = 2;
@@ -102,9 +139,19 @@ public:
 	bool 			gui;
 
 	std::string		outputFileName;
+	std::string		traceFileName;
+	std::string		reportFileName;
+	std::string		offsetsFileName;
+	std::string		locateFileName;
+	std::string		locatedFileName;
+	std::string		rasterFileName;
+	std::string		profileFileName;
+	std::string		binaryFileName;
+	std::string		exactFileName;
 
 private:
 	bool evaluateArguments(int argc, char *argv[]);
+	std::string besideOutput(const std::string& suffix) const;
 
 	std::string 	printOptions;
 	bool	 		validConfig;
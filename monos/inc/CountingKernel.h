@@ -0,0 +1,100 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COUNTINGKERNEL_H_
+#define COUNTINGKERNEL_H_
+
+#include <utility>
+
+#include <CGAL/Kernel/Type_equality_wrapper.h>
+
+#include "GeometryCounts.h"
+
+/* a kernel that behaves like its base kernel but counts the calls of the
+ * constructions and predicates monos relies on, see geometry::Op. It is an
+ * extension of the base kernel the way CGAL documents it: the functors are
+ * replaced and all kernel objects (Point_2<CountingKernel>, ...) use them,
+ * also inside the global functions such as CGAL::bisector or CGAL::intersection */
+namespace geometry {
+
+/* a functor of the base kernel, counting each call */
+template<class Functor, Op op>
+class Counted : public Functor {
+public:
+	Counted() = default;
+	Counted(const Functor& f) : Functor(f) {}
+
+	template<class... Args>
+	decltype(auto) operator()(Args&&... args) const {
+		++counts[op];
+		return Functor::operator()(std::forward<Args>(args)...);
+	}
+};
+
+template<class Kernel_, class BaseKernel>
+class CountingKernelBase : public BaseKernel::template Base<Kernel_>::Type {
+	using Old = typename BaseKernel::template Base<Kernel_>::Type;
+
+public:
+	using Kernel = Kernel_;
+
+	using Construct_bisector_2         = Counted<typename Old::Construct_bisector_2,BISECTOR>;
+	using Intersect_2                  = Counted<typename Old::Intersect_2,INTERSECTION>;
+	using Compute_squared_distance_2   = Counted<typename Old::Compute_squared_distance_2,SQUARED_DISTANCE>;
+	using Do_intersect_2               = Counted<typename Old::Do_intersect_2,DO_INTERSECT>;
+	using Orientation_2                = Counted<typename Old::Orientation_2,ORIENTATION>;
+	using Oriented_side_2              = Counted<typename Old::Oriented_side_2,ORIENTED_SIDE>;
+	using Compare_xy_2                 = Counted<typename Old::Compare_xy_2,COMPARE_XY>;
+
+	Construct_bisector_2 construct_bisector_2_object() const {
+		return Construct_bisector_2(Old::construct_bisector_2_object());
+	}
+	Intersect_2 intersect_2_object() const {
+		return Intersect_2(Old::intersect_2_object());
+	}
+	Compute_squared_distance_2 compute_squared_distance_2_object() const {
+		return Compute_squared_distance_2(Old::compute_squared_distance_2_object());
+	}
+	Do_intersect_2 do_intersect_2_object() const {
+		return Do_intersect_2(Old::do_intersect_2_object());
+	}
+	Orientation_2 orientation_2_object() const {
+		return Orientation_2(Old::orientation_2_object());
+	}
+	Oriented_side_2 oriented_side_2_object() const {
+		return Oriented_side_2(Old::oriented_side_2_object());
+	}
+	Compare_xy_2 compare_xy_2_object() const {
+		return Compare_xy_2(Old::compare_xy_2_object());
+	}
+
+	template<class Kernel2>
+	struct Base {
+		using Type = CountingKernelBase<Kernel2,BaseKernel>;
+	};
+};
+
+template<class BaseKernel>
+struct CountingKernel
+	: public CGAL::Type_equality_wrapper<CountingKernelBase<CountingKernel<BaseKernel>,BaseKernel>,
+										 CountingKernel<BaseKernel>> {};
+
+}
+
+#endif /* COUNTINGKERNEL_H_ */
@@ -41,6 +41,9 @@
 #include "Definitions.h"
 
 #include "BasicInput.h"
+#include "Arena.h"
+#include "Timings.h"
+#include "Statistics.h"
 
 
 class Data {
@@ -48,21 +51,21 @@ class Data {
 	using VertexIterator = VertexList::const_iterator;
 
 public:
-	Data(const BasicInput& input_):
-		input(input_) {}
+	Data(const BasicInput& input_, Arena& arena_, Timings& timings_, Statistics& statistics_):
+		arena(arena_), timings(timings_), statistics(statistics_), input(input_) {}
 
 	~Data() {delete bbox;}
 
 	const VertexList& getVertices() const { return input.vertices(); }
 	const EdgeList&   getPolygon()  const { return input.edges();    }
 
-	inline const Edge e(const ul& idx) const { return input.get_edge(idx); }
+	inline const Edge& e(const ul& idx) const { return input.get_edge(idx); }
 	const Vertex& v(const ul& idx) const { return getVertices()[idx]; }
 	const Point& p(const ul& idx) const { return v(idx).p; }
-	inline Line get_line(const ul& idx) const {return e(idx).line;}
-	inline Line get_line(const EdgeIterator& it) const {return it->line;}
-	Segment get_segment(const ul& idx) const {return e(idx).segment;}
-	Segment get_segment(const EdgeIterator& it) const {return it->segment;}
+	inline const Line& get_line(const ul& idx) const {return input.get_line(idx);}
+	inline const Line& get_line(const EdgeIterator& it) const {return input.get_line(it->id);}
+	Segment get_segment(const ul& idx) const {return input.get_segment(e(idx));}
+	Segment get_segment(const EdgeIterator& it) const {return input.get_segment(*it);}
 
 	const Point& eA(const ul& edgeIdx) const {return p(e(edgeIdx).u);}
 	const Point& eB(const ul& edgeIdx) const {return p(e(edgeIdx).v);}
@@ -70,6 +73,16 @@ public:
 	inline NT normalDistance(const ul& edgeIdx, const Point& p) const {
 		return CGAL::squared_distance(get_line(edgeIdx),p);
 	}
+	inline double signedDistance(const ul& edgeIdx, double x, double y) const {
+		return input.signed_distance(edgeIdx,x,y);
+	}
+
+	/* the supporting line of an edge moved inwards by 'offset', the time of
+	 * its points is offset^2 */
+	inline Line offsetLine(const ul& edgeIdx, const NT& offset) const {
+		const Line& l = get_line(edgeIdx);
+		return Line(l.a(),l.b(),l.c() - offset * squareRoot(l.a()*l.a() + l.b()*l.b()));
+	}
 
 	inline Line simpleBisector(const Line& a, const Line& b) const {
 		return CGAL::bisector(a,b.opposite());
@@ -94,6 +107,11 @@ public:
 
 	BBox			*bbox = nullptr;
 
+	/* every per-run structure allocates from here */
+	Arena&			arena;
+	Timings&		timings;
+	Statistics&		statistics;
+
 	EdgeIterator findEdgeWithVertex(const Vertex& v) const {
 		for(auto eit = getPolygon().begin(); eit != getPolygon().end(); ++eit) {
 			if(eit->u == v.id) {return eit;}
@@ -105,7 +123,6 @@ public:
 	EdgeIterator cPrev(EdgeIterator it) {return (it == getPolygon().begin()) ? std::prev(getPolygon().end()) : std::prev(it);}
 
 	/* write output & debug misc */
-	void addPolyToOBJ(const Config& cfg) const;
 	void printInput() const;
 	void printLineFormat();
 private:
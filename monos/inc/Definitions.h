@@ -33,6 +33,8 @@
 #define NIL    -1
 #define ZSCALE 0.5
 #define OBJSCALE 10
+/* significant digits of the numbers in the --exact sidecar */
+#define EXACT_DIGITS 64
 
 #define smallEPS 0.00000001
 
@@ -50,7 +52,7 @@ using ul = unsigned long;
 using sl = signed long;
 
 enum class NodeType   		: ul {TERMINAL=0,NORMAL,DISABLED};
-enum class ArcType    		: ul {NORMAL=0,RAY,DISABLED};
+enum class ArcType    		: unsigned char {NORMAL=0,RAY,DISABLED};
 enum class BisType    	   	: ul {RAY,LINE};
 enum class MonotoneType    	: ul {START=0,END};
 enum class ChainType    	: ul {UPPER=0,LOWER,BOTH};
@@ -19,17 +19,20 @@
 #pragma once
 
 #include <stddef.h>
+#include <memory_resource>
 
 #include "cgTypes.h"
 #include "Heap.h"
+#include "Statistics.h"
 
+/* a queue item only references the time of the event of edge 'edgeIdx' */
 class HeapEvent {
 public:
-	const Event * const e;
-	HeapEvent(const Event * p_t);
+	const NT * const t;
+	const ul edgeIdx;
+	HeapEvent(const NT * p_t, ul p_edgeIdx);
 
-	const NT& time() const { return e->eventTime; };
-	friend std::ostream& operator<<(std::ostream& os, const Event& e);
+	const NT& time() const { return *t; };
 public:
 	CGAL::Comparison_result compare(const HeapEvent &o) const {
 			 if (this->time() < o.time()) {
@@ -52,8 +55,8 @@ public:
 class EventQueueItem : public HeapItemBase <HeapEvent> {
 private:
 public:
-	EventQueueItem(const Event * e)
-	: HeapItemBase<HeapEvent>(HeapEvent(e))
+	EventQueueItem(const Events * events, ul edgeIdx)
+	: HeapItemBase<HeapEvent>(HeapEvent(&events->time(edgeIdx),edgeIdx))
 	{};
 };
 
@@ -63,17 +66,20 @@ private:
 
 private:
 	const Events* events;
-	std::vector<const Event *> need_update;
-	std::vector<const Event *> need_dropping;
+	/* queue items are allocated from the arena of the run */
+	std::pmr::polymorphic_allocator<EventQueueItem> itemAllocator;
+	Statistics* statistics;
+	std::vector<unsigned> need_update;
+	std::vector<unsigned> need_dropping;
 	FixedVector<bool> tidx_in_need_dropping;
 	FixedVector<bool> tidx_in_need_update;
 
 	FixedVector<ElementType> tidx_to_qitem_map;
 
-	void tidx_to_qitem_map_add(const Event * t, ElementType qi);
+	void tidx_to_qitem_map_add(unsigned tidx, ElementType qi);
 	void assert_no_pending() const;
 public:
-	EventQueue(const Events* setEvents, const Chain& chain);
+	EventQueue(const Events* setEvents, const Chain& chain, std::pmr::memory_resource* resource, Statistics* stats);
 
 	void drop_by_tidx(unsigned tidx);
 	void update_by_tidx(unsigned tidx);
@@ -97,11 +103,11 @@ public:
 
 	void process_pending_updates();
 
-	void needs_update(const Event * t, bool may_have_valid_collapse_spec = false);
-	void needs_dropping(Event * t);
+	void needs_update(unsigned tidx, bool may_have_valid_collapse_spec = false);
+	void needs_dropping(unsigned tidx);
 
 	bool in_needs_update(const ul edgeIdx) const;
-	bool in_needs_dropping(const Event * t) const;
+	bool in_needs_dropping(const ul edgeIdx) const;
 
 	bool is_valid_heap() const;
 };
@@ -0,0 +1,65 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GEOMETRYCOUNTS_H_
+#define GEOMETRYCOUNTS_H_
+
+#include <array>
+
+/* set by cmake (COUNT_GEOMETRY), replaces the kernel by the counting kernel
+ * of CountingKernel.h; without it nothing is counted and nothing is paid */
+#ifndef MONOS_COUNT_GEOMETRY
+#define MONOS_COUNT_GEOMETRY 0
+#endif
+
+namespace geometry {
+
+enum Op : unsigned {
+	BISECTOR = 0,		/* construct bisector */
+	INTERSECTION,		/* construct intersection */
+	SQUARED_DISTANCE,	/* compute squared distance */
+	DO_INTERSECT,		/* predicates */
+	ORIENTATION,
+	ORIENTED_SIDE,
+	COMPARE_XY,
+	SQRT,				/* square roots of numbers */
+	TO_DOUBLE,			/* conversions of numbers to double, i.e., forced evaluations */
+	NUM_OPS
+};
+
+static constexpr const char* opNames[NUM_OPS] = {
+	"bisector", "intersection", "squared_distance", "do_intersect",
+	"orientation", "oriented_side", "compare_xy", "sqrt", "to_double"
+};
+
+constexpr bool enabled() {return MONOS_COUNT_GEOMETRY != 0;}
+
+using Counts = std::array<unsigned long,NUM_OPS>;
+
+/* since the start of the process; the timings charge the difference
+ * between entering and leaving to the phase */
+extern Counts counts;
+
+inline void count(Op op) {
+	if constexpr (enabled()) {++counts[op];}
+}
+
+}
+
+#endif /* GEOMETRYCOUNTS_H_ */
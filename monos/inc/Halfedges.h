@@ -0,0 +1,69 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef HALFEDGES_H_
+#define HALFEDGES_H_
+
+#include <memory_resource>
+#include <vector>
+
+#include "cgTypes.h"
+#include "Definitions.h"
+#include "Data.h"
+
+/* the final skeleton as a half-edge structure (DCEL) over the node and arc
+ * indices: arc a is the pair of half-edges 2a, from its first to its second
+ * node in its left face, and 2a+1 back in its right face; polygon edge e is
+ * the pair 2m+2e, from u to v in its own face, and 2m+2e+1 outside, where m
+ * is the number of arcs. The twin of h is h^1. A face is indexed by its
+ * polygon edge, the outside and the plateau above a bounded wavefront are
+ * the face MAX */
+class Halfedges {
+public:
+	Halfedges(std::pmr::memory_resource* resource = std::pmr::get_default_resource()):
+		origins(resource), nexts(resource), prevs(resource), faces(resource) {}
+
+	/* after the compaction; returns the number of half-edges without a next one */
+	ul build(const Data& data, const Nodes& nodes, const ArcList& arcList);
+
+	inline bool empty() const {return origins.empty();}
+	inline ul size() const {return origins.size();}
+
+	inline ul twin(const ul& h)   const {return h ^ 1;}
+	inline ul origin(const ul& h) const {return origins[h];}
+	inline ul target(const ul& h) const {return origins[h ^ 1];}
+	inline ul next(const ul& h)   const {return nexts[h];}
+	inline ul prev(const ul& h)   const {return prevs[h];}
+	inline ul face(const ul& h)   const {return faces[h];}
+
+	/* the arc of a half-edge, MAX for the polygon */
+	inline ul arc(const ul& h) const {return (h < 2 * numArcs) ? h / 2 : MAX;}
+	/* the half-edge of a face on its polygon edge, it starts at u */
+	inline ul faceHalfedge(const ul& edgeIdx) const {return 2 * numArcs + 2 * edgeIdx;}
+
+private:
+	/* of the candidates leaving node 'at', the first one clockwise from the twin of h */
+	ul firstClockwise(const Nodes& nodes, const ul& h, const std::vector<ul>& candidates) const;
+
+	ul numArcs = 0;
+	std::pmr::vector<ul> origins, nexts, prevs, faces;
+};
+
+#endif /* HALFEDGES_H_ */
@@ -25,6 +25,7 @@
 
 #include "cgTypes.h"
 #include "tools.h"
+#include "Trace.h"
 #include <CGAL/assertions.h>
 
 template <class PriorityType,
@@ -187,7 +188,7 @@ class HeapBase {
      */
     void sift_up(const int child_idx) {
 //      DBG_FUNC_BEGIN(DBG_HEAP);
-      LOG(INFO)  << "heapelem#" << child_idx;
+      TRACE(HEAP, HEAP_SIFT_UP, child_idx);
 
       CGAL_precondition(child_idx >= 0 && child_idx < size());
 
@@ -217,7 +218,7 @@ class HeapBase {
     /** Fix the heap property with respect to a single element whose key has changed.
      */
     void fix_idx(int idx) {
-    	LOG(INFO) << "idx: " << idx << " and size: " << size(); fflush(stdout);
+      TRACE(HEAP, HEAP_FIX, idx, size());
       CGAL_precondition(idx >= 0 && idx < size());
 
       if (idx != 0 && (v_[idx]->priority <= v_[parent_idx(idx)]->priority)) {
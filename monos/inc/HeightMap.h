@@ -0,0 +1,67 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HEIGHTMAP_H_
+#define HEIGHTMAP_H_
+
+#include <string>
+#include <vector>
+
+#include "cgTypes.h"
+#include "Data.h"
+#include "Wavefront.h"
+
+/* the roof of the skeleton on a grid over the bounding box of the polygon.
+ * A scanline rasterizer: per row the arcs and polygon edges crossing it are
+ * sorted by x, between two crossings the pixels lie in the face right of
+ * the first one and its height is linear in x. Bands of rows are filled in
+ * parallel; outside of the polygon the height is 0, in the gaps between the
+ * fronts of a bounded run it is the maximum offset */
+class HeightMap {
+public:
+	HeightMap(const Data& _data, const Wavefront& _wf, const unsigned _width, const unsigned _height);
+
+	void rasterize(unsigned threads = 0);
+
+	/* portable float map (the float variant of PGM), rows bottom to top */
+	bool writePFM(const std::string& fileName) const;
+
+	/* row-major from the top left pixel, the height at the pixel centers */
+	std::vector<float> heights;
+	const unsigned width, height;
+
+private:
+	void rasterizeRows(const unsigned firstRow, const unsigned lastRow);
+
+	/* a segment that is not horizontal, from its bottom (x0,y0) up to y1,
+	 * and the face to its right */
+	struct Crossing {
+		double x0, y0, y1, dxdy;
+		ul face;
+	};
+
+	static constexpr ul PLATEAU = MAX - 1;
+
+	const Data& 	data;
+	std::vector<Crossing> segments;
+	double xMin = 0.0, yMax = 0.0, pixelWidth = 1.0, pixelHeight = 1.0;
+	double plateau = 0.0;
+};
+
+#endif /* HEIGHTMAP_H_ */
@@ -27,6 +27,9 @@
 #include "cgTypes.h"
 #include "Definitions.h"
 #include "BasicInput.h"
+#include "Arena.h"
+#include "Timings.h"
+#include "Statistics.h"
 
 #include "Wavefront.h"
 #include "Skeleton.h"
@@ -47,15 +50,20 @@ public:
 	bool readInput();
 	bool init();
 	void write();
+	void locatePoints();
 
 	const Config&   config;
 	const BasicInput* getBasicInput() {return &input;}
 
+	Arena			*arena	= nullptr;
 	Data			*data 	= nullptr;
 	Wavefront 		*wf 	= nullptr;
 	Skeleton		*s 		= nullptr;
 
 	BasicInput		input;
+	Timings			timings;
+	Statistics		statistics;
+	PerfCounters	perf;
 private:
 };
 
@@ -0,0 +1,84 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OBJWRITER_H_
+#define OBJWRITER_H_
+
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Definitions.h"
+
+/* writes an OBJ file through one large buffer that goes to the file only
+ * when it is full, numbers are formatted with std::to_chars (shortest
+ * representation that reads back to the same double). Lines are built
+ * from the pieces below, e.g., begin('f'), index(..) per vertex, end() */
+class ObjWriter {
+public:
+	ObjWriter(const std::string& fileName, const std::size_t capacity = 1 << 20);
+	~ObjWriter();
+
+	ObjWriter(const ObjWriter&) = delete;
+	ObjWriter& operator=(const ObjWriter&) = delete;
+
+	/* false if the file could not be opened or a write failed */
+	inline bool good() const {return file != nullptr && !failed;}
+
+	void comment(const std::string& text);
+
+	/* 'v x y z' lines for n vertices; large batches are formatted by
+	 * several threads into their own buffers and written in order */
+	void vertices(const double* xs, const double* ys, const double* zs, const ul n, unsigned threads = 0);
+	void vertex(const double x, const double y, const double z);
+
+	inline void begin(const char type) {reserve(2); put(type);}
+	/* a vertex reference, +1 is the standard OBJ offset for references */
+	inline void index(const ul idx) {reserve(24); put(' '); number(idx + 1);}
+	inline void end() {reserve(1); put('\n');}
+
+	void flush();
+
+private:
+	/* room for at least n more characters */
+	inline void reserve(const std::size_t n) {if(used + n > buffer.size()) {flush();}}
+	inline void put(const char c) {buffer[used++] = c;}
+	inline void number(const ul x) {
+		used = std::to_chars(buffer.data() + used,buffer.data() + buffer.size(),x).ptr - buffer.data();
+	}
+	inline void number(const double x) {
+		used = std::to_chars(buffer.data() + used,buffer.data() + buffer.size(),x).ptr - buffer.data();
+	}
+
+	void write(const char* data, const std::size_t size);
+
+	/* one 'v x y z' line never exceeds this */
+	static constexpr std::size_t VERTEX_LINE = 4 + 3 * 25;
+	/* vertices per thread below which the batch is formatted in place */
+	static constexpr ul PARALLEL_VERTICES = 1 << 16;
+
+	std::FILE* 			file = nullptr;
+	std::vector<char> 	buffer;
+	std::size_t 		used = 0;
+	bool 				failed = false;
+};
+
+#endif /* OBJWRITER_H_ */
@@ -0,0 +1,81 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OFFSETS_H_
+#define OFFSETS_H_
+
+#include <map>
+#include <vector>
+
+#include "cgTypes.h"
+#include "Config.h"
+#include "Data.h"
+#include "Wavefront.h"
+
+/* offset curves (insets) of the polygon read off the final skeleton: at
+ * offset d the curve crosses every arc whose lower node is at most and
+ * whose upper node is above d, within the face of an edge it runs parallel
+ * to that edge. A face is monotone with respect to its edge, thus walking
+ * along its boundary the crossings pair up consecutively.
+ *
+ * The nodes are swept once by time for all offsets, an arc is added to the
+ * active set at its lower node and removed at its upper node; an offset
+ * only reads the active arcs, i.e., its own output */
+class Offsets {
+public:
+	/* the polygons of one offset, each oriented like the input polygon */
+	struct Curve {
+		NT offset;
+		std::vector<std::vector<Point>> polygons;
+	};
+
+	Offsets(const Data& _data, const Wavefront& _wf);
+
+	/* offsets in ascending order, one curve per offset */
+	std::vector<Curve> extract(const std::vector<NT>& offsets);
+
+	/* the curves as closed lines, at the height of their offset */
+	void writeOBJ(const Config& cfg, const std::vector<Curve>& curves) const;
+
+private:
+	void walkFace(const ul& edgeIdx);
+	void addNode(const ul& nodeIdx);
+	void emit(Curve& curve);
+
+	/* where the offset crosses an active arc, interpolated between its nodes */
+	Point crossing(const Arc& arc, const NT& offset) const;
+
+	const Data& 		data;
+	const Wavefront& 	wf;
+
+	/* position of an arc on the boundary of its left/right face, walking
+	 * from the right (v) to the left (u) vertex of the edge */
+	std::vector<ul> leftPosition, rightPosition;
+	/* distance of a node to the boundary, i.e., the square root of its time */
+	std::vector<NT> distance;
+	/* nodes sorted by time and the rank of a node in that order */
+	std::vector<ul> order, rank;
+
+	/* active arcs by face and position on its boundary */
+	std::map<std::pair<ul,ul>,ul> active;
+	/* the next crossing along the curve of the current offset */
+	std::vector<ul> next;
+};
+
+#endif /* OFFSETS_H_ */
@@ -0,0 +1,62 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERFCOUNTERS_H_
+#define PERFCOUNTERS_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+enum class HwCounter : unsigned {CYCLES=0,INSTRUCTIONS,CACHE_REFERENCES,CACHE_MISSES,BRANCHES,BRANCH_MISSES,NUM_COUNTERS};
+
+/* hardware counters of this process (user space only) through
+ * perf_event_open, Linux only. Every counter is opened on its own, a
+ * counter the machine or the container does not provide is just missing;
+ * if none can be opened the counters are not available and read zero */
+class PerfCounters {
+public:
+	static constexpr unsigned NUM = static_cast<unsigned>(HwCounter::NUM_COUNTERS);
+	using Values = std::array<uint64_t,NUM>;
+
+	PerfCounters() {fds.fill(-1);}
+	~PerfCounters();
+
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	/* returns false if no counter could be opened, see error() */
+	bool open();
+
+	bool available() const;
+	inline bool available(HwCounter c) const {return fds[static_cast<unsigned>(c)] >= 0;}
+
+	/* since open(), scaled up if the kernel had to multiplex the counters */
+	Values read() const;
+
+	const std::string& error() const {return lastError;}
+
+	static const char* name(HwCounter c);
+
+private:
+	std::array<int,NUM> fds;
+	std::string lastError;
+};
+
+#endif /* PERFCOUNTERS_H_ */
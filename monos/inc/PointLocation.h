@@ -0,0 +1,83 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef POINTLOCATION_H_
+#define POINTLOCATION_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "cgTypes.h"
+#include "Data.h"
+#include "Wavefront.h"
+
+/* point location in the faces of the final skeleton, in doubles. The arcs
+ * and the polygon edges are non-crossing segments; a segment tree over the
+ * x-coordinates of their endpoints stores every segment in the O(log n)
+ * nodes whose x-range it spans, where the segments of a node are ordered
+ * by y. A query walks from the root to the leaf of its x and searches each
+ * node on the way for the segment right below the point; the face above
+ * the highest of them contains the point. O(n log n) space, O(log^2 n) per
+ * query, no exact arithmetic once built */
+class PointLocation {
+public:
+	PointLocation(const Data& _data, const Wavefront& _wf);
+
+	/* the edge whose face contains (x,y), MAX outside of the polygon */
+	ul face(const double x, const double y) const;
+
+	/* the roof height at (x,y) in the face of an edge, i.e., the distance to its line */
+	inline double height(const ul& edgeIdx, const double x, const double y) const {
+		return data.signedDistance(edgeIdx,x,y);
+	}
+
+	/* batched queries, faces and heights (0 outside) are written per query */
+	void locate(const double* x, const double* y, const std::size_t n, ul* faces, double* heights) const;
+
+private:
+	/* the index of the highest segment of node 'nodeIdx' at or below (x,y), MAX if none */
+	inline std::size_t below(const std::size_t nodeIdx, const double x, const double y) const {
+		std::size_t first = nodeOffsets[nodeIdx], len = nodeOffsets[nodeIdx+1] - first;
+		const double dx = x - nodeMidX[nodeIdx];
+		while(len > 0) {
+			const std::size_t half = len / 2;
+			const bool isBelow = midY[first + half] + slope[first + half] * dx <= y;
+			first = isBelow ? first + half + 1 : first;
+			len   = isBelow ? len - half - 1   : half;
+		}
+		return (first > nodeOffsets[nodeIdx]) ? first - 1 : MAX;
+	}
+
+	std::size_t leaf(const double x) const;
+
+	const Data& 		data;
+
+	/* elementary x-intervals [xs[i],xs[i+1]], the leaves of the tree */
+	std::vector<double> xs;
+	std::size_t numLeaves = 0;
+
+	/* per node its x-range midpoint and its segments (CSR), as structure of
+	 * arrays: y at the midpoint, slope and the face above the segment */
+	std::vector<double> 	 nodeMidX;
+	std::vector<std::size_t> nodeOffsets;
+	std::vector<double> 	 midY, slope;
+	std::vector<ul> 		 faceAbove;
+};
+
+#endif /* POINTLOCATION_H_ */
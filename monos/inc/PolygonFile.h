@@ -0,0 +1,56 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef POLYGONFILE_H_
+#define POLYGONFILE_H_
+
+#include <cstdint>
+#include <cstring>
+
+/* binary polygon input, for inputs too large to parse as GraphML:
+ * the header followed by 'numVertices' pairs of doubles (x, y) in native
+ * byte order, the vertices in counter-clockwise order; the edges are
+ * implicit, from every vertex to the next and from the last to the first */
+namespace polygonfile {
+
+static constexpr char MAGIC[8] = {'M','O','N','O','S','P','L','Y'};
+static constexpr uint32_t VERSION = 1;
+
+struct Header {
+	char     magic[8];
+	uint32_t version;
+	uint32_t reserved;
+	uint64_t numVertices;
+};
+
+inline Header makeHeader(uint64_t numVertices) {
+	Header header = {};
+	std::memcpy(header.magic,MAGIC,sizeof(MAGIC));
+	header.version = VERSION;
+	header.numVertices = numVertices;
+	return header;
+}
+
+inline bool isValid(const Header& header) {
+	return std::memcmp(header.magic,MAGIC,sizeof(MAGIC)) == 0 && header.version == VERSION;
+}
+
+}
+
+#endif /* POLYGONFILE_H_ */
@@ -0,0 +1,75 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <array>
+#include <vector>
+
+#include "cgTypes.h"
+#include "Config.h"
+#include "Data.h"
+#include "Wavefront.h"
+
+/* area and perimeter of the offset polygons as functions of the offset t,
+ * read off the final skeleton in one sweep over its nodes. Within the face
+ * of an edge the curve at offset t has the length of the signed projection
+ * onto the edge of where it crosses the boundary of the face; each crossing
+ * moves linearly along its arc, thus the perimeter is linear and the area,
+ * its negative integral, quadratic between consecutive node offsets.
+ *
+ * Note that t is the distance to the boundary, the time of a node is t^2.
+ * Computed in NT, i.e., exact unless built WITH_FP */
+class Profile {
+public:
+	/* the offsets [from,to] between two consecutive nodes, the polynomials
+	 * are in x = t - from */
+	struct Piece {
+		NT from, to;
+		std::array<NT,3> area;
+		std::array<NT,2> perimeter;
+	};
+
+	Profile(const Data& _data, const Wavefront& _wf);
+
+	/* t is clamped to [0,end()], past a bounded wavefront nothing is known */
+	NT area(const NT& t) const;
+	NT perimeter(const NT& t) const;
+
+	/* the volume below the roof, up to the front of a bounded wavefront */
+	NT volume() const {return totalVolume;}
+	NT end() const {return pieces.empty() ? NT(0) : pieces.back().to;}
+
+	/* one line 'from to a0 a1 a2 p0 p1' per piece after the volume */
+	void write(const Config& cfg) const;
+
+	std::vector<Piece> pieces;
+
+private:
+	const Piece* pieceAt(const NT& t, NT& x) const;
+
+	const Data& 		data;
+	const Wavefront& 	wf;
+
+	NT totalVolume = NT(0);
+};
+
+#endif /* PROFILE_H_ */
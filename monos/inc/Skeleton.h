@@ -56,9 +56,22 @@ public:
 	void finishMerge();
 
 	void writeOBJ(const Config& cfg) const;
+	/* the binary format of SkeletonFile.h and, if asked for, its exact sidecar */
+	bool writeBinary(const Config& cfg) const;
 
 	bool computationFinished = false;
 
+	/* a bounded merge (Wavefront::setMaxTime) ends where the merge line passes
+	 * the limit and resumes where the lower and upper front meet again; in
+	 * between the fronts stay apart, a gap keeps their edges from left to
+	 * right and the front vertices between consecutive edges */
+	struct FrontGap {
+		ul leaveNodeIdx = MAX, enterNodeIdx = MAX;
+		std::vector<ul>    lower, upper;
+		std::vector<Point> lowerPoints, upperPoints;
+	};
+	std::vector<FrontGap> gaps;
+
 	void storeChains(Chain upper, Chain lower) {
 		upperChain = upper;
 		lowerChain = lower;
@@ -70,8 +83,15 @@ private:
 
 	void removePath(const ul& arcIdx, const ul& edgeIdx);
 
+	bool beyondLimit(const IntersectionPair& intersectionPair) const;
+	bool crossGap(const Line& bis);
+	bool findGapEnd(FrontGap& gap, ul& upperIdx, ul& lowerIdx, Point& P);
+	Point frontVertex(const ul& aIdx, const ul& bIdx) const;
+	ul clipRay(const ul& arcIdx, const Point& P);
+	void closeFronts();
+
 	ul handleMerge(const IntersectionPair& intersectionPair, bool possibleGhostArcToRepair);
-	void updateArcTarget(const ul& arcIdx, const ul& edgeIdx, const int& secondNodeIdx, const Point& edgeEndPoint);
+	void updateArcTarget(const ul& arcIdx, const ul& edgeIdx, const ul& secondNodeIdx);
 
 	bool EndOfBothChains() const {return EndOfUpperChain() && EndOfLowerChain();  }
 	bool EndOfUpperChain() const {return upperChainIndex == upperChain.front(); }
@@ -84,7 +104,6 @@ private:
 	inline ChainType chooseWinnerUpperLower(const Point& Pu, const Point& Pl) const {
 		ChainType winner;
 		if(Pu != INFPOINT && Pl != INFPOINT) {
-			LOG(INFO) << "Pl and Pu are not INF";
 			if(Pu.x() != Pl.x()) {
 				winner = (Pu < Pl) ? ChainType::UPPER : ChainType::LOWER;
 			} else if (Pu != Pl) {
@@ -104,8 +123,8 @@ private:
 	void initPathForEdge(ChainType type);
 
 	inline bool isIntersecting(const Line& l, const Arc& arc) {
-		bool a = l.has_on_positive_side(arc.source());
-		bool b = l.has_on_positive_side(arc.target());
+		bool a = l.has_on_positive_side(wf.getArcSource(arc));
+		bool b = l.has_on_positive_side(wf.getArcTarget(arc));
 		return (a && !b) || (!a && b);
 	}
 
@@ -0,0 +1,183 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SKELETONFILE_H_
+#define SKELETONFILE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* binary skeleton output, written by --binary and read without parsing:
+ * the header followed by the sections below at the byte offsets given in
+ * the header, each aligned to 8 bytes, in native byte order
+ *  - nodes:    numNodes records (x, y, time), the time is the offset distance
+ *  - arcs:     numArcs records (first, second node, left, right face)
+ *  - faces:    numFaces + 1 offsets into the face nodes (CSR), face i is
+ *              faceNodes[faceOffsets[i]] .. faceNodes[faceOffsets[i+1]-1]
+ *  - polygon:  numPolygon node indices of the input polygon, counter-clockwise
+ * Face i belongs to edge i of the polygon, from polygon[i] to polygon[i+1].
+ * NONE marks a missing face, e.g., right of a front arc of a bounded run.
+ *
+ * The file has no dependencies on monos or CGAL, downstream code may copy
+ * it. Nodes are doubles; the numbers of the kernel, if asked for (--exact),
+ * are in a text sidecar, one 'x y time' line per node with EXACT_DIGITS
+ * significant digits (all of them for doubles, WITH_FP) */
+namespace skeletonfile {
+
+static constexpr char MAGIC[8] = {'M','O','N','O','S','S','K','L'};
+static constexpr uint32_t VERSION = 1;
+static constexpr uint64_t NONE = UINT64_MAX;
+
+struct Header {
+	char     magic[8];
+	uint32_t version;
+	uint32_t reserved;
+	uint64_t numNodes, numArcs, numFaces, numFaceNodes, numPolygon;
+	uint64_t nodesOffset, arcsOffset, faceOffsetsOffset, faceNodesOffset, polygonOffset;
+};
+
+struct NodeRecord {
+	double x, y, time;
+};
+
+struct ArcRecord {
+	uint64_t first, second;
+	uint64_t left, right;
+};
+
+/* the sections one after the other behind the header */
+inline Header makeHeader(uint64_t numNodes, uint64_t numArcs, uint64_t numFaces,
+		uint64_t numFaceNodes, uint64_t numPolygon) {
+	Header header = {};
+	std::memcpy(header.magic,MAGIC,sizeof(MAGIC));
+	header.version 			 = VERSION;
+	header.numNodes 		 = numNodes;
+	header.numArcs 			 = numArcs;
+	header.numFaces 		 = numFaces;
+	header.numFaceNodes 	 = numFaceNodes;
+	header.numPolygon 		 = numPolygon;
+	header.nodesOffset 		 = sizeof(Header);
+	header.arcsOffset 		 = header.nodesOffset + numNodes * sizeof(NodeRecord);
+	header.faceOffsetsOffset = header.arcsOffset + numArcs * sizeof(ArcRecord);
+	header.faceNodesOffset 	 = header.faceOffsetsOffset + (numFaces + 1) * sizeof(uint64_t);
+	header.polygonOffset 	 = header.faceNodesOffset + numFaceNodes * sizeof(uint64_t);
+	return header;
+}
+
+inline bool isValid(const Header& header) {
+	return std::memcmp(header.magic,MAGIC,sizeof(MAGIC)) == 0 && header.version == VERSION;
+}
+
+/* a skeleton file mapped into memory, the arrays point into the mapping
+ * and are valid as long as the reader lives */
+class Reader {
+public:
+	Reader() = default;
+	explicit Reader(const std::string& fileName) {open(fileName);}
+	~Reader() {close();}
+
+	Reader(const Reader&) = delete;
+	Reader& operator=(const Reader&) = delete;
+
+	/* false if the file cannot be mapped or is not a valid skeleton file */
+	bool open(const std::string& fileName) {
+		close();
+		const int fd = ::open(fileName.c_str(),O_RDONLY);
+		if(fd < 0) {return false;}
+		struct stat st;
+		if(fstat(fd,&st) == 0 && static_cast<uint64_t>(st.st_size) >= sizeof(Header)) {
+			length = st.st_size;
+			void* map = mmap(nullptr,length,PROT_READ,MAP_PRIVATE,fd,0);
+			base = (map != MAP_FAILED) ? static_cast<const char*>(map) : nullptr;
+		}
+		::close(fd);
+		if(base == nullptr || !fits()) {
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void close() {
+		if(base != nullptr) {munmap(const_cast<char*>(base),length);}
+		base = nullptr;
+		length = 0;
+	}
+
+	inline bool isOpen() const {return base != nullptr;}
+	inline const Header& header() const {return *reinterpret_cast<const Header*>(base);}
+
+	inline uint64_t numNodes()   const {return header().numNodes;}
+	inline uint64_t numArcs()    const {return header().numArcs;}
+	inline uint64_t numFaces()   const {return header().numFaces;}
+	inline uint64_t numPolygon() const {return header().numPolygon;}
+
+	inline const NodeRecord* nodes()   const {return at<NodeRecord>(header().nodesOffset);}
+	inline const ArcRecord*  arcs()    const {return at<ArcRecord>(header().arcsOffset);}
+	inline const uint64_t* faceOffsets() const {return at<uint64_t>(header().faceOffsetsOffset);}
+	inline const uint64_t* faceNodes()   const {return at<uint64_t>(header().faceNodesOffset);}
+	inline const uint64_t* polygon()     const {return at<uint64_t>(header().polygonOffset);}
+
+	/* the nodes of face i and their number */
+	inline const uint64_t* face(const uint64_t i) const {return faceNodes() + faceOffsets()[i];}
+	inline uint64_t faceSize(const uint64_t i) const {return faceOffsets()[i + 1] - faceOffsets()[i];}
+
+private:
+	template<class T>
+	inline const T* at(const uint64_t offset) const {return reinterpret_cast<const T*>(base + offset);}
+
+	/* every section lies in the file, counts are checked against the size
+	 * before they are multiplied so a broken header cannot overflow */
+	bool fits() const {
+		const Header& h = header();
+		if(!isValid(h)) {return false;}
+		auto inside = [&](uint64_t offset, uint64_t count, uint64_t size) {
+			return offset % 8 == 0 && offset <= length && count <= (length - offset) / size;
+		};
+		if(!inside(h.nodesOffset,h.numNodes,sizeof(NodeRecord))
+		|| !inside(h.arcsOffset,h.numArcs,sizeof(ArcRecord))
+		|| h.numFaces == NONE
+		|| !inside(h.faceOffsetsOffset,h.numFaces + 1,sizeof(uint64_t))
+		|| !inside(h.faceNodesOffset,h.numFaceNodes,sizeof(uint64_t))
+		|| !inside(h.polygonOffset,h.numPolygon,sizeof(uint64_t))) {
+			return false;
+		}
+		/* the CSR offsets start at 0, never decrease and stay within the
+		 * face nodes, so face(i) and faceSize(i) cannot leave the mapping */
+		const uint64_t* offsets = faceOffsets();
+		if(offsets[0] != 0) {return false;}
+		for(uint64_t i = 0; i < h.numFaces; ++i) {
+			if(offsets[i + 1] < offsets[i]) {return false;}
+		}
+		return offsets[h.numFaces] <= h.numFaceNodes;
+	}
+
+	const char* base 	= nullptr;
+	uint64_t 	length 	= 0;
+};
+
+}
+
+#endif /* SKELETONFILE_H_ */
@@ -0,0 +1,62 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATISTICS_H_
+#define STATISTICS_H_
+
+#include <algorithm>
+#include <ostream>
+
+/* what a run of monos did, to relate slow inputs to the parts of the
+ * algorithm they stress; counted unconditionally, an increment each */
+class Statistics {
+public:
+	/* wavefront propagation */
+	unsigned long singleEvents    = 0;	/* edge events of a single edge */
+	unsigned long multiEvents     = 0;	/* edge events of several edges at one point */
+	unsigned long multiEventEdges = 0;	/* edges collapsing in multi events */
+	unsigned long staleEvents     = 0;	/* events discarded, before the current time */
+	unsigned long reinserts       = 0;	/* updated events no longer in the queue */
+	unsigned long peakQueueSize   = 0;
+
+	/* merge */
+	unsigned long mergeSteps      = 0;	/* calls of findNextIntersectingArc */
+	unsigned long arcsVisited     = 0;	/* arcs tested for an intersection, over all steps */
+	unsigned long maxArcsVisited  = 0;	/* in a single step */
+	unsigned long ghostArcRepairs = 0;
+	unsigned long disabledArcs    = 0;	/* arcs removed by the merge, dropped by compaction */
+
+	inline void queueSize(unsigned long size) {peakQueueSize = std::max(peakQueueSize,size);}
+	inline void mergeStep(unsigned long visited) {
+		++mergeSteps;
+		arcsVisited   += visited;
+		maxArcsVisited = std::max(maxArcsVisited,visited);
+	}
+
+	double arcsVisitedPerStep() const {
+		return (mergeSteps > 0) ? static_cast<double>(arcsVisited) / mergeSteps : 0.0;
+	}
+
+	/* a single JSON object */
+	void writeJSON(std::ostream& os) const;
+
+	friend std::ostream& operator<< (std::ostream& os, const Statistics& stats);
+};
+
+#endif /* STATISTICS_H_ */
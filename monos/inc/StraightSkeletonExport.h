@@ -0,0 +1,105 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef STRAIGHTSKELETONEXPORT_H_
+#define STRAIGHTSKELETONEXPORT_H_
+
+#include <memory>
+#include <vector>
+
+#include <CGAL/Straight_skeleton_2.h>
+
+#include "cgTypes.h"
+#include "Wavefront.h"
+
+/* copies the final skeleton into CGAL's Straight_skeleton_2 (a HalfedgeDS),
+ * e.g., std::shared_ptr<CGAL::Straight_skeleton_2<Epick>>, for users of
+ * the CGAL straight skeleton package; monos-compare --export checks it.
+ * The half-edges keep their indices as ids, arc a is 2a and 2a+1, see
+ * Halfedges.h; vertices and faces keep the node and edge indices. The
+ * outside (and in a bounded run the plateau) are border half-edges, i.e.,
+ * without a face.
+ *
+ * Coordinates and times (the offset distance of a node) are converted
+ * through doubles. CGAL's own builder marks split vertices, this is not
+ * known here and they are exported as plain skeleton vertices */
+template<class SS>
+std::shared_ptr<SS> exportStraightSkeleton(const Wavefront& wf) {
+	using Traits 	= typename SS::Traits;
+	using FT		= typename Traits::FT;
+	using Point_2	= typename Traits::Point_2;
+	using Vertex 	= typename SS::Vertex;
+	using Halfedge 	= typename SS::Halfedge;
+	using Face 		= typename SS::Face;
+
+	const auto& he 		= wf.halfedges;
+	const ul numEdges 	= (he.size() - he.faceHalfedge(0)) / 2;
+
+	auto ss = std::make_shared<SS>();
+
+	std::vector<typename SS::Vertex_handle> vertices;
+	vertices.reserve(wf.nodes.size());
+	for(const auto& node : wf.nodes) {
+		const Point_2 p(toDouble(node.point.x()),toDouble(node.point.y()));
+		if(node.isTerminal()) {
+			vertices.push_back(ss->vertices_push_back(Vertex(node.id,p)));
+		} else {
+			const FT time(toDouble(squareRoot(node.time)));
+			vertices.push_back(ss->vertices_push_back(Vertex(node.id,p,time,false,false)));
+		}
+	}
+
+	std::vector<typename SS::Face_handle> faces;
+	faces.reserve(numEdges);
+	for(ul edgeIdx = 0; edgeIdx < numEdges; ++edgeIdx) {
+		faces.push_back(ss->faces_push_back(Face(edgeIdx)));
+	}
+
+	/* a ray is not connected, its pair of half-edges is left out */
+	std::vector<typename SS::Halfedge_handle> halfedges(he.size());
+	for(ul h = 0; h < he.size(); h += 2) {
+		if(he.origin(h) == MAX) {continue;}
+		halfedges[h]     = ss->edges_push_back(Halfedge(h),Halfedge(h + 1));
+		halfedges[h + 1] = halfedges[h]->opposite();
+	}
+
+	for(ul h = 0; h < he.size(); ++h) {
+		if(he.origin(h) == MAX) {continue;}
+		auto handle = halfedges[h];
+		if(he.next(h) != MAX) {handle->set_next(halfedges[he.next(h)]);}
+		if(he.prev(h) != MAX) {handle->set_prev(halfedges[he.prev(h)]);}
+		/* a CGAL half-edge points to its target */
+		handle->set_vertex(vertices[he.target(h)]);
+		vertices[he.target(h)]->set_halfedge(handle);
+		if(he.face(h) != MAX) {handle->set_face(faces[he.face(h)]);}
+	}
+
+	/* the halfedge of a face is the one on its polygon edge, the one of a
+	 * polygon vertex is the polygon half-edge ending there */
+	for(ul edgeIdx = 0; edgeIdx < numEdges; ++edgeIdx) {
+		auto handle = halfedges[he.faceHalfedge(edgeIdx)];
+		faces[edgeIdx]->set_halfedge(handle);
+		handle->vertex()->set_halfedge(handle);
+	}
+
+	return ss;
+}
+
+#endif /* STRAIGHTSKELETONEXPORT_H_ */
@@ -0,0 +1,95 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TIMINGS_H_
+#define TIMINGS_H_
+
+#include <array>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "GeometryCounts.h"
+#include "AllocationCounts.h"
+#include "PerfCounters.h"
+
+class Statistics;
+
+enum class Phase : unsigned {READ=0,DECOMPOSE,INIT_QUEUE,LOWER_CHAIN,UPPER_CHAIN,MERGE,COMPACTION,WRITE,NUM_PHASES};
+
+/* wall time (monotonic clock), cpu time, change of the resident set and the
+ * geometric operations, heap allocations and hardware counters (see
+ * GeometryCounts.h, AllocationCounts.h and PerfCounters.h) per phase of a
+ * run; phases may nest, the inner phase pauses the outer one, so every
+ * moment is charged to exactly one phase */
+class Timings {
+public:
+	struct Report {
+		double   wall     = 0.0;	/* seconds */
+		double   cpu      = 0.0;	/* seconds */
+		long     rssDelta = 0;		/* kB */
+		unsigned calls    = 0;
+		geometry::Counts ops = {};	/* only with COUNT_GEOMETRY */
+		allocation::Counts allocs;	/* only with COUNT_ALLOCATIONS */
+		PerfCounters::Values hw = {};	/* only with hardware counters set */
+	};
+
+	class Scope {
+	public:
+		Scope(Timings& t, Phase p):timings(t) {timings.enter(p);}
+		~Scope() {timings.leave();}
+	private:
+		Timings& timings;
+	};
+
+	/* sample these counters as well, they have to be open already */
+	void setPerfCounters(const PerfCounters* counters) {perf = counters;}
+
+	void enter(Phase p);
+	void leave();
+
+	const Report& operator[](Phase p) const {return reports[static_cast<unsigned>(p)];}
+
+	/* sum over the phases first, ..., last */
+	Report sum(Phase first, Phase last) const;
+
+	/* the statistics of the run are included if given */
+	void writeJSON(std::ostream& os, const std::string& fileName, unsigned long numVertices,
+			const Statistics* statistics = nullptr) const;
+
+	static const char* name(Phase p);
+
+private:
+	struct Sample {
+		double wall, cpu;
+		long   rss;
+		geometry::Counts ops;
+		allocation::Counts allocs;
+		PerfCounters::Values hw;
+	};
+	Sample now() const;
+	void charge(Phase p, const Sample& s);
+
+	std::array<Report,static_cast<unsigned>(Phase::NUM_PHASES)> reports;
+	std::vector<Phase> running;
+	Sample last = {0.0,0.0,0,{},{},{}};
+	const PerfCounters* perf = nullptr;
+};
+
+#endif /* TIMINGS_H_ */
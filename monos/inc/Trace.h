@@ -0,0 +1,126 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* bitmask of the trace categories compiled in, set by cmake (TRACE_CATEGORIES);
+ * a category that is not compiled in costs nothing, not even its arguments */
+#ifndef MONOS_TRACE
+#define MONOS_TRACE 0
+#endif
+
+namespace trace {
+
+enum Category : uint16_t {
+	INPUT  = 1,
+	EVENTS = 2,
+	HEAP   = 4,
+	MERGE  = 8,
+	OUTPUT = 16
+};
+
+/* what is recorded, the meaning of the two integers a, b and the value */
+enum Id : uint16_t {
+	INPUT_EDGE = 0,		/* a: vertex u, b: vertex v */
+	DEQUEUE,			/* a: edge, b: queue size, value: time */
+	EDGE_EVENT,			/* a: edge, b: 1 if it collapses, value: time */
+	EVENT_DISCARDED,	/* a: edge, value: event time before the current time */
+	SINGLE_EVENT,		/* a: edge, value: time */
+	MULTI_EVENT,		/* a: node, b: number of collapsing edges, value: time */
+	ADD_ARC,			/* a: arc, b: first node */
+	ADD_RAY,			/* a: arc, b: first node */
+	QUEUE_DROP,			/* a: edge */
+	QUEUE_UPDATE,		/* a: edge, b: 1 if it was re-inserted */
+	HEAP_SIFT_UP,		/* a: heap index */
+	HEAP_FIX,			/* a: heap index, b: heap size */
+	MERGE_STEP,			/* a: upper chain edge, b: lower chain edge */
+	MERGE_CHECK_ARC,	/* a: arc, b: 0 upper, 1 lower chain */
+	MERGE_NODE,			/* a: new node, b: previous source node */
+	MERGE_ARC_TARGET,	/* a: arc, b: new second node */
+	WRITE_OBJ,			/* a: nodes, b: arcs */
+	NUM_IDS
+};
+
+static constexpr const char* idNames[NUM_IDS] = {
+	"input-edge", "dequeue", "edge-event", "event-discarded", "single-event",
+	"multi-event", "add-arc", "add-ray", "queue-drop", "queue-update",
+	"heap-sift-up", "heap-fix", "merge-step", "merge-check-arc", "merge-node",
+	"merge-arc-target", "write-obj"
+};
+
+constexpr bool enabled(uint16_t category) {return (MONOS_TRACE & category) != 0;}
+
+struct Record {
+	uint64_t ns;		/* since the start of the process */
+	uint16_t category;
+	uint16_t id;
+	uint32_t reserved;
+	uint64_t a, b;
+	double   value;
+};
+
+/* layout of a dump: the header followed by 'stored' records, oldest first */
+struct Header {
+	char     magic[8];	/* "MONOSTRC" */
+	uint32_t version;
+	uint32_t recordSize;
+	uint64_t recorded;	/* total number of records, older ones are overwritten */
+	uint64_t stored;
+};
+
+/* fixed size ring of binary records, writers claim a slot with a single
+ * atomic increment and never wait; the oldest records are overwritten */
+class Ring {
+public:
+	static constexpr std::size_t SIZE = 1 << 16;
+
+	inline void record(uint16_t category, uint16_t id, uint64_t a, uint64_t b = 0, double value = 0.0) {
+		const uint64_t slot = head.fetch_add(1,std::memory_order_relaxed);
+		const uint64_t ns   = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count();
+		records[slot & (SIZE - 1)] = {ns,category,id,0,a,b,value};
+	}
+
+	bool dump(const std::string& fileName) const;
+
+private:
+	std::atomic<uint64_t> head{0};
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Record records[SIZE];
+};
+
+extern Ring ring;
+
+}
+
+#define TRACE(category, id, ...) \
+	do { \
+		if constexpr (trace::enabled(trace::category)) { \
+			trace::ring.record(trace::category, trace::id, __VA_ARGS__); \
+		} \
+	} while(0)
+
+#endif /* TRACE_H_ */
@@ -23,6 +23,7 @@
 #include "cgTypes.h"
 #include "Definitions.h"
 #include "Data.h"
+#include "Halfedges.h"
 
 #include "EventQueue.h"
 
@@ -36,21 +37,28 @@ public:
 	void nextState() {
 		if(state == STATE::LOWER) {
 			delete eventTimes;
+			eventTimes = nullptr;
 			state = STATE::UPPER;
 		} else if(state == STATE::UPPER) {
 			state = STATE::MERGE;
 		}
 	}
 
-	Wavefront(Data& dat):data(dat) {}
+	Wavefront(Data& dat):
+		nodes(&dat.arena), arcList(&dat.arena),
+		rayTargets(&dat.arena), adjacency(&dat.arena), halfedges(&dat.arena),
+		pathFinder(&dat.arena), frontRays(&dat.arena),
+		upperChain(dat.getPolygon().size()),
+		lowerChain(dat.getPolygon().size()),
+		data(dat) {}
 	~Wavefront() {delete eventTimes;}
 	bool InitSkeletonQueue(Chain& chain);
 	bool SingleDequeue(Chain& chain);
 	bool FinishSkeleton(Chain& chain);
 
-	void HandleSingleEdgeEvent(Chain& chain, const Event* event);
-	void HandleMultiEdgeEvent(Chain& chain, std::vector<const Event*> eventList);
-	void HandleMultiEvent(Chain& chain, std::vector<const Event*> eventList);
+	void HandleSingleEdgeEvent(Chain& chain, const ul& edgeIdx);
+	void HandleMultiEdgeEvent(Chain& chain, const std::vector<ul>& eventList);
+	void HandleMultiEvent(Chain& chain, std::vector<ul>& eventList);
 
 	void InitializeEventsAndPathsPerEdge();
 	void InitializeNodes();
@@ -58,28 +66,37 @@ public:
 	void ChainDecomposition();
 	bool ComputeSkeleton(ChainType type);
 
+	/* stop the wavefront at the given offset: events later than offset^2
+	 * stay in the queue and the merge ends on the fronts, see Skeleton */
+	void setMaxTime(const NT& offset) {
+		bounded   = true;
+		maxOffset = offset;
+		maxTime   = offset * offset;
+	}
+	inline bool isBounded() const {return bounded;}
+
+	/* remove what the merge cut off the skeleton and renumber densely */
+	void compact();
+
 	Chain& getChain(ChainType type) {return (type == ChainType::UPPER) ? upperChain : lowerChain;}
 
 	inline Line getNormalBisector(const ul& aIdx, const ul& bIdx, const Line& l) const {
 		return l.perpendicular(nodes[pathFinder[aIdx].b].point);
 	}
 
-	Event getEdgeEvent(const ul& aIdx, const ul& bIdx, const ul& cIdx, const ChainRef& it) const;
-	void updateNeighborEdgeEvents(const Event& event, const Chain& chain);
+	Event getEdgeEvent(const ul& aIdx, const ul& bIdx, const ul& cIdx) const;
+	void updateNeighborEdgeEvents(const ul& edgeIdx, const Chain& chain);
 	void updateInsertEvent(Event& event);
 
-	inline void disableEdge(ul edgeIdx) {
-		events[edgeIdx].eventPoint = INFPOINT;
-		events[edgeIdx].eventTime = 0;
-	}
+	inline void disableEdge(ul edgeIdx) {events.disable(edgeIdx);}
 
 	/* construct skeletal structure using nodes and arcs */
 	ul addArcRay(const ul& nodeAIdx, const ul& edgeLeft, const ul& edgeRight, const Ray& ray);
 	ul addArc(const ul& nodeAIdx, const ul& nodeBIdx, const ul& edgeLeft, const ul& edgeRight);
-	void addNewNodefromEvent(const Event&);
+	void addNewNodefromEvent(const ul& edgeIdx);
 
 	inline ul addNode(const Point& intersection, const NT& time, NodeType type = NodeType::NORMAL) {
-		nodes.emplace_back(Node(type,intersection,time, nodes.size()));
+		nodes.emplace_back(type,intersection,time,nodes.size());
 		return nodes.size() - 1;
 	}
 
@@ -94,6 +111,16 @@ public:
 	inline Node* getNode(const ul& idx) {return &nodes[idx];}
 	inline Arc* getArc(const ul& idx) {assert(idx < arcList.size()); return &arcList[idx];}
 
+	/* arcs only store indices, their geometry is looked up from the nodes;
+	 * the target of a ray is its intersection with the bounding box */
+	inline const Point& getArcSource(const Arc& arc) const {return nodes[arc.firstNodeIdx].point;}
+	inline const Point& getArcTarget(const Arc& arc) const {
+		return (arc.secondNodeIdx != MAX) ? nodes[arc.secondNodeIdx].point : rayTargets[arc.id];
+	}
+	inline Segment getArcSegment(const Arc& arc) const {return Segment(getArcSource(arc),getArcTarget(arc));}
+	inline Line getArcLine(const Arc& arc) const {return getArcSegment(arc).supporting_line();}
+	bool arcHasOnY(const Arc& arc, const NT& y) const;
+
 	ul getNextArcIdx(const ul& path, bool forward, ul edgeIdx);
 
 	Arc* getRightmostArcEndingAtNode(const Node& node, Arc *currentArc);
@@ -106,18 +133,35 @@ public:
 	/* the chain skeleton and the final skeleton is stored in nodes and arcList */
 	Nodes				nodes;
 	ArcList				arcList;
+	/* a ray has no second node, its target clipped to the bounding box is
+	 * computed once when it is added (by arc index, INFPOINT for the others) */
+	std::pmr::vector<Point> rayTargets;
+	/* compact adjacency of the final skeleton, built after the merge */
+	NodeArcAdjacency 	adjacency;
+	/* the same as half-edges with next, twin and face, see Halfedges.h */
+	Halfedges			halfedges;
 	/* helping to find the paths, holds for every edge of polygon
 	 * the index to the last node on the left/right path */
 	PathFinder 			pathFinder;
 
+	/* a bounded run keeps, for every edge of a remaining chain, the ray to
+	 * its successor in that chain (indexed by the edge, MAX if there is none) */
+	bool				bounded = false;
+	NT					maxOffset = MAX, maxTime = MAX;
+	std::pmr::vector<ul> frontRays;
+
 	/* EVENT QUEUE --------------------------------------------------------------------
 	 * Events stored in events, priority queue is weasel's heap -> 'heap.h'
-	 * we place Event* in the Queue Items and sort by eventTime
+	 * the Queue Items reference the event time of an edge and sort by it
 	 */
 	Events 			events;
 	EventQueue 		*eventTimes = nullptr;
 	NT				currentTime = 0;
 
+	/* scratch buffers reused by every batch of simultaneous events */
+	std::vector<ul> eventBatch, multiBatch, multiEdgeEvent;
+	std::vector<std::pair<ul,ul>> edgePairs;
+
 	template<class T, class U>
 	inline bool isCollinear(const T& a, const U& b) const {
 		return CGAL::collinear(a.point(0),a.point(1),b.point(0)+b.to_vector());
@@ -128,7 +172,7 @@ public:
 	void printEvents() const;
 
 private:
-	Segment restrictRay(const Ray& ray);
+	Point restrictRay(const Point& Pa, const Direction& dir) const;
 
 	Chain  			upperChain, lowerChain;
 	Data&    		data;
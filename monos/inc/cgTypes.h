@@ -27,17 +27,31 @@
 #include <functional>
 #include <queue>
 #include <set>
+#include <memory_resource>
 #include <cmath>
 
+#include <boost/container/small_vector.hpp>
+
 #include "Definitions.h"
 #include "tools.h"
+#include "GeometryCounts.h"
 
 #ifdef WITH_FP
 #include <CGAL/Cartesian.h>
-using K 			 	= CGAL::Cartesian<double>;
+using BaseKernel	 	= CGAL::Cartesian<double>;
 #else
 #include <CGAL/Exact_predicates_exact_constructions_kernel_with_sqrt.h>
-using K 			 	= CGAL::Exact_predicates_exact_constructions_kernel_with_sqrt;
+using BaseKernel	 	= CGAL::Exact_predicates_exact_constructions_kernel_with_sqrt;
+#endif
+
+#if MONOS_COUNT_GEOMETRY
+#include "CountingKernel.h"
+using K 			 	= geometry::CountingKernel<BaseKernel>;
+#else
+using K 			 	= BaseKernel;
+#endif
+
+#ifndef WITH_FP
 using Transformation 	= CGAL::Aff_transformation_2<K>;
 using Intersect		 	= K::Intersect_2;
 #endif
@@ -57,8 +71,78 @@ using Direction      	= K::Direction_2;
 using Segment      	 	= K::Segment_2;
 using NT 	         	= K::FT;
 
-using Chain 			= std::list<ul>;
-using ChainRef			= Chain::iterator;
+/* numbers leave the kernel through these two, counted with COUNT_GEOMETRY */
+inline double toDouble(const NT& x) {
+	geometry::count(geometry::TO_DOUBLE);
+	return CGAL::to_double(x);
+}
+inline NT squareRoot(const NT& x) {
+	geometry::count(geometry::SQRT);
+	return CGAL::sqrt(x);
+}
+
+/* a chain of the wavefront, a doubly linked list of edge indices stored as flat
+ * prev/next arrays indexed by the edge index. An edge is at most once in a chain,
+ * removing it only relinks its neighbours. MAX marks the ends of the chain. */
+class Chain {
+public:
+	class const_iterator {
+	public:
+		const_iterator(const Chain* c, ul idx): chain(c), idx(idx) {}
+		ul operator*() const {return idx;}
+		const_iterator& operator++() {idx = chain->next(idx); return *this;}
+		bool operator==(const const_iterator& rhs) const {return idx == rhs.idx;}
+		bool operator!=(const const_iterator& rhs) const {return idx != rhs.idx;}
+	private:
+		const Chain* chain;
+		ul idx;
+	};
+
+	Chain(ul numEdges = 0): prevIdx(numEdges,MAX), nextIdx(numEdges,MAX) {}
+
+	void push_back(const ul& idx) {
+		if(idx >= nextIdx.size()) {
+			prevIdx.resize(idx+1,MAX);
+			nextIdx.resize(idx+1,MAX);
+		}
+		assert(!contains(idx));
+		prevIdx[idx] = tail;
+		nextIdx[idx] = MAX;
+		if(tail != MAX) {nextIdx[tail] = idx;} else {head = idx;}
+		tail = idx;
+		++count;
+	}
+
+	void erase(const ul& idx) {
+		assert(contains(idx));
+		const ul p = prevIdx[idx], n = nextIdx[idx];
+		if(p != MAX) {nextIdx[p] = n;} else {head = n;}
+		if(n != MAX) {prevIdx[n] = p;} else {tail = p;}
+		prevIdx[idx] = MAX;
+		nextIdx[idx] = MAX;
+		--count;
+	}
+
+	inline bool contains(const ul& idx) const {
+		return idx < nextIdx.size() && (idx == head || prevIdx[idx] != MAX);
+	}
+
+	inline ul next(const ul& idx) const {return nextIdx[idx];}
+	inline ul prev(const ul& idx) const {return prevIdx[idx];}
+
+	inline ul front() const {return head;}
+	inline ul back()  const {return tail;}
+	inline ul size()  const {return count;}
+	inline bool empty() const {return count == 0;}
+
+	const_iterator begin() const {return const_iterator(this,head);}
+	const_iterator end()   const {return const_iterator(this,MAX);}
+
+private:
+	std::vector<ul> prevIdx, nextIdx;
+	ul head = MAX, tail = MAX;
+	ul count = 0;
+};
 
 using PointIterator 	= std::vector<Point>::const_iterator;
 
@@ -76,15 +160,15 @@ public:
 	friend std::ostream& operator<< (std::ostream& os, const Vertex& vertex);
 };
 
+/* an input edge only references its vertices, the supporting lines are
+ * kept in the edge table of BasicInput (indexed by 'id') */
 class Edge {
 public:
 	const unsigned u, v;
 	const unsigned id;
-	const Segment segment;
-	const Line line;
 
-	Edge(unsigned u, unsigned v, unsigned id, Segment s)
-	: u(u), v(v), id(id), segment(s), line(s.supporting_line()) {}
+	Edge(unsigned u, unsigned v, unsigned id)
+	: u(u), v(v), id(id) {}
 
 	inline bool has(const unsigned idx) const {return u == idx || v == idx;}
 
@@ -132,22 +216,20 @@ struct MonVectCmp {
 
 class Event {
 public:
-	Event(NT time = MAX, Point point = INFPOINT, ul edgeA = 0, ul edgeB = 0, ul edgeC = 0, ChainRef ref = ChainRef()):
+	Event(NT time = MAX, Point point = INFPOINT, ul edgeA = 0, ul edgeB = 0, ul edgeC = 0):
 		eventTime(time),
 		eventPoint(point),
 		leftEdge(edgeA),
 		mainEdge(edgeB),
-		rightEdge(edgeC),
-		chainEdge(ref) {}
+		rightEdge(edgeC) {}
 
 	inline bool isEvent() const { return eventPoint != INFPOINT;}
 
 	NT	         	eventTime;
 	Point  			eventPoint;
+	/* the main edge is also the reference into the chain */
 	ul 				leftEdge, mainEdge, rightEdge;
 
-	ChainRef 		chainEdge;
-
 	inline bool operator==(const Event& rhs) const {
 		return this->leftEdge == rhs.leftEdge
 			&& this->mainEdge == rhs.mainEdge
@@ -159,14 +241,63 @@ public:
 	friend std::ostream& operator<< (std::ostream& os, const Event& event);
 };
 
-using Events		     = FixedVector<Event>;
+/* the events of the wavefront, one per edge and indexed by its (main) edge,
+ * stored as structure of arrays: the event queue only touches the event
+ * times, the points and neighbours are read when an event is handled */
+class Events {
+public:
+	void resize(const ul& size) {
+		eventTimes.resize(size,MAX);
+		eventPoints.resize(size,INFPOINT);
+		leftEdges.resize(size,0);
+		rightEdges.resize(size,0);
+	}
+
+	inline ul size() const {return eventTimes.size();}
 
-class Arc : public Segment {
+	inline const NT&    time(const ul& idx)  const {return eventTimes[idx];}
+	inline const Point& point(const ul& idx) const {return eventPoints[idx];}
+	inline ul leftEdge(const ul& idx)  const {return leftEdges[idx];}
+	inline ul rightEdge(const ul& idx) const {return rightEdges[idx];}
+
+	inline bool isEvent(const ul& idx) const {return eventPoints[idx] != INFPOINT;}
+
+	void set(const Event& event) {
+		const ul idx = event.mainEdge;
+		eventTimes[idx]  = event.eventTime;
+		eventPoints[idx] = event.eventPoint;
+		leftEdges[idx]   = event.leftEdge;
+		rightEdges[idx]  = event.rightEdge;
+	}
+
+	/* an update only writes what it changes */
+	inline void setTime(const ul& idx, NT time)       {eventTimes[idx]  = std::move(time);}
+	inline void setPoint(const ul& idx, Point point)  {eventPoints[idx] = std::move(point);}
+	inline void setNeighbours(const ul& idx, const ul& left, const ul& right) {
+		leftEdges[idx]  = left;
+		rightEdges[idx] = right;
+	}
+
+	void disable(const ul& idx) {
+		eventPoints[idx] = INFPOINT;
+		eventTimes[idx]  = 0;
+	}
+
+private:
+	FixedVector<NT> 	eventTimes;
+	FixedVector<Point> 	eventPoints;
+	FixedVector<ul> 	leftEdges, rightEdges;
+};
+
+/* an arc is a plain index record: it references its two nodes and the two
+ * faces (edges) left and right of it. The geometry is not stored but looked
+ * up from the nodes when a predicate needs it, see Wavefront::getArcSegment.
+ * A ray has no second node, its clipped target is kept in Wavefront::rayTargets */
+class Arc {
 public:
-	Arc(ArcType t, ul firstNode, ul secondNode, ul leftEdge, ul rightEdge, unsigned id, Segment e) :
-		Segment(e),
-		type(t), firstNodeIdx(firstNode), secondNodeIdx(secondNode),
-		leftEdgeIdx(leftEdge), rightEdgeIdx(rightEdge), id(id)
+	Arc(ArcType t, ul firstNode, ul secondNode, ul leftEdge, ul rightEdge, unsigned id) :
+		firstNodeIdx(firstNode), secondNodeIdx(secondNode),
+		leftEdgeIdx(leftEdge), rightEdgeIdx(rightEdge), id(id), type(t)
 	{}
 
 	ul getCommonNodeIdx(const Arc& arc) {
@@ -194,24 +325,16 @@ public:
 	inline bool isDisable() const {return type == ArcType::DISABLED;}
 	inline void disable() {type = ArcType::DISABLED;}
 
-	bool hasEndPoint(const Point& P) const {
-		return P == source() || P == target();
-	}
-
-	bool has_on_y(const NT& y) {
-		return (point(0).y() < y && point(1).y() > y)
-			|| (point(0).y() > y && point(1).y() < y);
-	}
-
-	ArcType type;
 	ul firstNodeIdx, secondNodeIdx;
 	ul leftEdgeIdx,  rightEdgeIdx;
 	unsigned id;
+	ArcType type;
 
 	friend std::ostream& operator<< (std::ostream& os, const Arc& arc);
 };
 
-using ArcList		= std::vector<Arc>;
+/* nodes, arcs and the path finder live in the arena of the run, see Arena.h */
+using ArcList		= std::pmr::vector<Arc>;
 
 struct ArcCmp {
 	ArcCmp(const ArcList& list):arcList(list) {}
@@ -226,6 +349,9 @@ struct ArcCmp {
 };
 
 
+/* almost every node has degree three, those are stored inline in the node */
+using NodeArcs 		= boost::container::small_vector<ul,3>;
+
 struct Node {
 	Node(const NodeType t, const Point p, NT time, unsigned id): type(t), point(p), time(time), id(id) {}
 
@@ -235,7 +361,7 @@ struct Node {
 	unsigned		id;
 
 	/* all incident arcs, i.e., the indices to them */
-	std::vector<ul> 	arcs;
+	NodeArcs 		arcs;
 
 	void disable() {type = NodeType::DISABLED;}
 	bool isDisabled() const { return type == NodeType::DISABLED;}
@@ -264,6 +390,44 @@ struct Node {
 	friend std::ostream& operator<< (std::ostream& os, const Node& node);
 };
 
+/* the inputPoints index equals the terminal node index,
+ * as from every vertex emits an arc */
+using Nodes 		= std::pmr::vector<Node>;
+
+/* node-arc incidences of the final skeleton in compressed (CSR) form, only
+ * arcs that are not disabled are kept: the arcs of node i are
+ * arcIndices[offsets[i]], ..., arcIndices[offsets[i+1]-1] */
+class NodeArcAdjacency {
+public:
+	NodeArcAdjacency(std::pmr::memory_resource* resource = std::pmr::get_default_resource()):
+		offsets(resource), arcIndices(resource) {}
+
+	void build(const Nodes& nodes, const ArcList& arcList) {
+		offsets.clear();
+		arcIndices.clear();
+		offsets.reserve(nodes.size() + 1);
+		offsets.push_back(0);
+		for(const auto& node : nodes) {
+			for(auto arcIdx : node.arcs) {
+				if(!arcList[arcIdx].isDisable()) {
+					arcIndices.push_back(arcIdx);
+				}
+			}
+			offsets.push_back(arcIndices.size());
+		}
+	}
+
+	inline bool empty() const {return offsets.empty();}
+
+	inline const ul* begin(const ul& nodeIdx) const {return arcIndices.data() + offsets[nodeIdx];}
+	inline const ul* end(const ul& nodeIdx)   const {return arcIndices.data() + offsets[nodeIdx+1];}
+	inline ul degree(const ul& nodeIdx) const {return offsets[nodeIdx+1] - offsets[nodeIdx];}
+
+private:
+	std::pmr::vector<ul> offsets;
+	std::pmr::vector<ul> arcIndices;
+};
+
 class EndNodes {
 public:
 	EndNodes(sl a_ = NIL, sl b_ = NIL):
@@ -271,10 +435,7 @@ public:
 	sl a, b;
 };
 
-/* the inputPoints index equals the terminal node index,
- * as from every vertex emits an arc */
-using Nodes 		= std::vector<Node>;
-using PathFinder    = std::vector<EndNodes>;
+using PathFinder    = std::pmr::vector<EndNodes>;
 
 inline NT normalDistance(const Line& l, const Point& p) {return CGAL::squared_distance(l,p);}
 
@@ -0,0 +1,97 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounts.h"
+
+namespace allocation {
+
+Counts counts;
+
+}
+
+#if MONOS_COUNT_ALLOCATIONS
+/* the replaceable global allocation functions, every form of new ends in
+ * one of the two allocate functions and every delete in release */
+
+static void* allocate(std::size_t size) {
+	++allocation::counts.allocations;
+	allocation::counts.bytes += size;
+	return std::malloc(size > 0 ? size : 1);
+}
+
+static void* allocate(std::size_t size, std::align_val_t alignment) {
+	++allocation::counts.allocations;
+	allocation::counts.bytes += size;
+	const std::size_t a = static_cast<std::size_t>(alignment);
+	/* aligned_alloc wants a multiple of the alignment, and at least one
+	 * block since size 0 may give null, which new would throw on */
+	return std::aligned_alloc(a,size > 0 ? (size + a - 1) / a * a : a);
+}
+
+static void release(void* p) {
+	if(p == nullptr) {return;}
+	++allocation::counts.frees;
+	std::free(p);
+}
+
+void* operator new(std::size_t size) {
+	void* p = allocate(size);
+	if(p == nullptr) {throw std::bad_alloc();}
+	return p;
+}
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return allocate(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	void* p = allocate(size,alignment);
+	if(p == nullptr) {throw std::bad_alloc();}
+	return p;
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+	return operator new(size,alignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	return allocate(size,alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	return allocate(size,alignment);
+}
+
+void operator delete(void* p) noexcept {release(p);}
+void operator delete[](void* p) noexcept {release(p);}
+void operator delete(void* p, std::size_t) noexcept {release(p);}
+void operator delete[](void* p, std::size_t) noexcept {release(p);}
+void operator delete(void* p, const std::nothrow_t&) noexcept {release(p);}
+void operator delete[](void* p, const std::nothrow_t&) noexcept {release(p);}
+void operator delete(void* p, std::align_val_t) noexcept {release(p);}
+void operator delete[](void* p, std::align_val_t) noexcept {release(p);}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {release(p);}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {release(p);}
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {release(p);}
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {release(p);}
+#endif
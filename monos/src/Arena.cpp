@@ -0,0 +1,79 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Arena.h"
+
+static const std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+static std::size_t roundUp(std::size_t size, std::size_t to) {
+	return ((size + to - 1) / to) * to;
+}
+
+Arena::Arena(std::size_t initialSize, bool hugePages):
+	buffer(mapBuffer(initialSize,hugePages)),
+	pool(buffer.data,buffer.size,&upstream) {}
+
+Arena::~Arena() {
+	pool.release();
+	munmap(buffer.data,buffer.size);
+}
+
+Arena::Buffer Arena::mapBuffer(std::size_t size, bool hugePages) {
+	const int prot  = PROT_READ | PROT_WRITE;
+	const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+	if(hugePages) {
+		size = roundUp(size,HUGE_PAGE_SIZE);
+#ifdef MAP_HUGETLB
+		/* explicit huge pages, only available if reserved by the system */
+		void* p = mmap(nullptr,size,prot,flags | MAP_HUGETLB,-1,0);
+		if(p != MAP_FAILED) {return {p,size,true};}
+#endif
+		/* otherwise ask for transparent huge pages */
+		void* q = mmap(nullptr,size,prot,flags,-1,0);
+		if(q == MAP_FAILED) {throw std::bad_alloc();}
+#ifdef MADV_HUGEPAGE
+		bool huge = madvise(q,size,MADV_HUGEPAGE) == 0;
+#else
+		bool huge = false;
+#endif
+		return {q,size,huge};
+	}
+
+	size = roundUp(std::max<std::size_t>(size,1),sysconf(_SC_PAGESIZE));
+	void* p = mmap(nullptr,size,prot,flags,-1,0);
+	if(p == MAP_FAILED) {throw std::bad_alloc();}
+	return {p,size,false};
+}
+
+double Arena::release() {
+	auto start = std::chrono::steady_clock::now();
+	pool.release();
+	allocations = 0;
+	bytes       = 0;
+	std::chrono::duration<double> spent = std::chrono::steady_clock::now() - start;
+	return spent.count();
+}
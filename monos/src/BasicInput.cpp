@@ -18,6 +18,8 @@
 
 #include "cgTypes.h"
 #include "BasicInput.h"
+#include "PolygonFile.h"
+#include "Trace.h"
 
 void
 BasicInput::add_graph(const BGLGraph& graph) {
@@ -51,7 +53,7 @@ BasicInput::add_graph(const BGLGraph& graph) {
 
 	std::vector<sl> map(vertices_.size(), NIL);
 	for(const auto& e : edgePairs) {
-		LOG(INFO) << std::get<0>(e) << " " <<  std::get<1>(e);
+		TRACE(INPUT, INPUT_EDGE, std::get<0>(e), std::get<1>(e));
 		if(map[std::get<0>(e)] == NIL) {
 			map[std::get<0>(e)] = std::get<1>(e);
 		} else if(map[std::get<1>(e)] == NIL) {
@@ -61,9 +63,71 @@ BasicInput::add_graph(const BGLGraph& graph) {
 		}
 	}
 
+	edges_.reserve(vertices_.size());
+	lines_.reserve(vertices_.size());
+	line_a_.reserve(vertices_.size());
+	line_b_.reserve(vertices_.size());
+	line_c_.reserve(vertices_.size());
+
 	unsigned idx = 0;
 	do {
 		add_edge(idx,map[idx]);
 		idx = map[idx];
 	} while(idx != 0);
 }
+
+bool
+BasicInput::add_polygon(std::istream& in) {
+	assert(vertices_.size() == 0);
+	assert(edges_.size() == 0);
+
+	polygonfile::Header header;
+	if(!in.read(reinterpret_cast<char*>(&header),sizeof(header)) || !polygonfile::isValid(header)
+	   || header.numVertices < 3) {
+		return false;
+	}
+
+	const std::size_t n = header.numVertices;
+	vertices_.reserve(n);
+	edges_.reserve(n);
+	lines_.reserve(n);
+	line_a_.reserve(n);
+	line_b_.reserve(n);
+	line_c_.reserve(n);
+
+	/* read in blocks, a single read of 10^8 vertices needs its own 1.6 GB */
+	std::vector<double> block(2 * 4096);
+	for(std::size_t i = 0; i < n;) {
+		const std::size_t count = std::min<std::size_t>(n - i, block.size() / 2);
+		if(!in.read(reinterpret_cast<char*>(block.data()),count * 2 * sizeof(double))) {
+			return false;
+		}
+		for(std::size_t k = 0; k < count; ++k, ++i) {
+			add_vertex(Vertex(Point(block[2*k],block[2*k+1]), vertices_.size()));
+		}
+	}
+
+	for(unsigned idx = 0; idx < n; ++idx) {
+		const unsigned next = (idx + 1 < n) ? idx + 1 : 0;
+		TRACE(INPUT, INPUT_EDGE, idx, next);
+		add_edge(idx,next);
+	}
+	return true;
+}
+
+void
+BasicInput::add_line(const Point& a, const Point& b) {
+	lines_.emplace_back(Line(a,b));
+
+	double ax = toDouble(a.x()), ay = toDouble(a.y());
+	double bx = toDouble(b.x()), by = toDouble(b.y());
+	double la = ay - by;
+	double lb = bx - ax;
+	double len = std::sqrt(la*la + lb*lb);
+	assert(len > 0.0);
+	la /= len; lb /= len;
+
+	line_a_.push_back(la);
+	line_b_.push_back(lb);
+	line_c_.push_back(-(la*ax + lb*ay));
+}
@@ -19,8 +19,12 @@
 
 #include "Config.h"
 
+#include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <sstream>
+
 bool Config::evaluateArguments(int argc, char *argv[]) {
 	while (1) {
 		int option_index = 0;
@@ -54,6 +58,67 @@ bool Config::evaluateArguments(int argc, char *argv[]) {
 			not_x_mon = true;
 			break;
 
+		case 'p':
+			hugePages = true;
+			break;
+
+		case 'r':
+			traceFileName = std::string(optarg);
+			break;
+
+		case 'j':
+			reportFileName = std::string(optarg);
+			break;
+
+		case 'c':
+			perfCounters = true;
+			break;
+
+		case 'm':
+			maxOffset = atof(optarg);
+			if(maxOffset <= 0.0) {
+				std::cerr << "--max-time expects a positive offset" << std::endl;
+				exit(1);
+			}
+			break;
+
+		case 'f': {
+			std::stringstream list(optarg);
+			std::string value;
+			while(std::getline(list,value,',')) {
+				offsets.push_back(atof(value.c_str()));
+				if(offsets.back() < 0.0) {
+					std::cerr << "--insets expects non-negative distances" << std::endl;
+					exit(1);
+				}
+			}
+			std::sort(offsets.begin(),offsets.end());
+			break;
+		}
+
+		case 'l':
+			locateFileName = std::string(optarg);
+			break;
+
+		case 'g':
+			if(sscanf(optarg,"%ux%u",&rasterWidth,&rasterHeight) != 2 || rasterWidth == 0 || rasterHeight == 0) {
+				std::cerr << "--raster expects the grid size as <width>x<height>" << std::endl;
+				exit(1);
+			}
+			break;
+
+		case 'a':
+			profile = true;
+			break;
+
+		case 'b':
+			binary = true;
+			break;
+
+		case 'e':
+			exact = true;
+			break;
+
 		default:
 			std::cerr << "Invalid option " << (char)r << std::endl;
 			validConfig = false;
@@ -65,6 +130,30 @@ bool Config::evaluateArguments(int argc, char *argv[]) {
 		usage(argv[0], 1);
 	}
 
+	/* the side outputs are named after the skeleton output */
+	const bool sideOutputs = !offsets.empty() || !locateFileName.empty() || rasterWidth > 0 || profile || binary;
+	if(sideOutputs && outputFileName.empty()) {
+		std::cerr << "--insets, --locate, --raster, --profile and --binary need --out" << std::endl;
+		exit(1);
+	}
+
+	if(!offsets.empty()) {
+		offsetsFileName = besideOutput("-offsets.obj");
+	}
+	if(!locateFileName.empty()) {
+		locatedFileName = besideOutput("-located.txt");
+	}
+	if(rasterWidth > 0) {
+		rasterFileName = besideOutput("-height.pfm");
+	}
+	if(profile) {
+		profileFileName = besideOutput("-profile.txt");
+	}
+	if(binary) {
+		binaryFileName = besideOutput(".mskl");
+		if(exact) {exactFileName = besideOutput("-exact.txt");}
+	}
+
 	use_stdin = true;
 	if (argc - optind == 1) {
 		std::string fn(argv[optind]);
@@ -77,3 +166,12 @@ bool Config::evaluateArguments(int argc, char *argv[]) {
 	return true;
 }
 
+
+/* further output goes next to the skeleton, out.obj -> out<suffix> */
+std::string Config::besideOutput(const std::string& suffix) const {
+	const auto ext = outputFileName.rfind(".obj");
+	if(ext != std::string::npos && ext + 4 == outputFileName.size()) {
+		return outputFileName.substr(0,ext) + suffix;
+	}
+	return outputFileName + suffix;
+}
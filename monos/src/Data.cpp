@@ -282,22 +282,3 @@ void Data::printLineFormat() {
 	std::cout << p(getPolygon().back().v) << std::endl;
 }
 
-/*
- * NOTE: this only works if writeOBJ was invoced before, as we only
- * add a face with the indices that require the vertices already in
- * the file
- * */
-void Data::addPolyToOBJ(const Config& cfg) const {
-	double xt, yt, zt, xm, ym, zm;
-	getNormalizer(*bbox,xt,xm,yt,ym,zt,zm);
-
-	std::ofstream outfile (cfg.outputFileName,std::ofstream::binary | std::ofstream::app);
-
-	outfile << "f";
-	for(auto e : getPolygon()) {
-		outfile << " " << e.u+1;
-	}
-
-	outfile << std::endl;
-	outfile.close();
-}
@@ -17,41 +17,44 @@
  */
 
 #include "EventQueue.h"
+#include "Trace.h"
 
 HeapEvent::
-HeapEvent(const Event *  p_t)
-: e(p_t)
+HeapEvent(const NT * p_t, ul p_edgeIdx)
+: t(p_t), edgeIdx(p_edgeIdx)
 {
 }
 
 EventQueue::
-EventQueue(const Events* setEvents, const Chain& chain):events(setEvents) {
+EventQueue(const Events* setEvents, const Chain& chain, std::pmr::memory_resource* resource, Statistics* stats):
+	events(setEvents), itemAllocator(resource), statistics(stats) {
 	ArrayType a;
+	a.reserve(chain.size());
 	tidx_to_qitem_map.resize(events->size(), NULL);
 	tidx_in_need_dropping.resize(events->size(), false);
 	tidx_in_need_update.resize(events->size(), false);
 
 	/* we skip the first and last edge of each chain */
-	for (auto t = std::next(chain.begin()); t != std::prev(chain.end()); ++t) {
-		auto qi = std::make_shared<EventQueueItem>(&(*events)[*t]);
+	for (ul t = chain.next(chain.front()); t != chain.back(); t = chain.next(t)) {
+		auto qi = std::allocate_shared<EventQueueItem>(itemAllocator,events,t);
 		a.emplace_back(qi);
-		tidx_to_qitem_map_add(&(*events)[*t], qi);
+		tidx_to_qitem_map_add(t, qi);
 	}
 	setArray(a);
+	statistics->queueSize(size());
 }
 
 void
 EventQueue::
-tidx_to_qitem_map_add(const Event * t, ElementType qi) {
-	unsigned id = t->mainEdge;
-	assert(id < tidx_to_qitem_map.size());
-	tidx_to_qitem_map[id] = qi;
+tidx_to_qitem_map_add(unsigned tidx, ElementType qi) {
+	assert(tidx < tidx_to_qitem_map.size());
+	tidx_to_qitem_map[tidx] = qi;
 }
 
 void
 EventQueue::
 drop_by_tidx(unsigned tidx) {
-	LOG(INFO) << "___ dropping idx: " << tidx;
+	TRACE(HEAP, QUEUE_DROP, tidx);
 	auto qi = tidx_to_qitem_map.at(tidx);
 	assert(NULL != qi);
 	drop_element(qi);
@@ -68,11 +71,12 @@ update_by_tidx(unsigned tidx) {
 	 * so no assertion needed here, instead we 're'-insert such an event
 	 * as this should not occur to often hopefully performance does not drop */
 	if(qi == NULL) {
-		LOG(INFO) << "|||| re-insert idx: " << tidx;
+		TRACE(HEAP, QUEUE_UPDATE, tidx, 1);
+		++statistics->reinserts;
 		insert(tidx);
 	} else {
 		assert(NULL != qi);
-		LOG(INFO) << "update time of " << tidx;
+		TRACE(HEAP, QUEUE_UPDATE, tidx, 0);
 		fix_idx(qi);
 		tidx_in_need_update[tidx] = false;
 	}
@@ -81,9 +85,10 @@ update_by_tidx(unsigned tidx) {
 void
 EventQueue::
 insert(unsigned tidx) {
-	auto qi = std::make_shared<EventQueueItem>(&(*events)[tidx]);
-	tidx_to_qitem_map_add(&(*events)[tidx], qi);
+	auto qi = std::allocate_shared<EventQueueItem>(itemAllocator,events,tidx);
+	tidx_to_qitem_map_add(tidx, qi);
 	add_element(qi);
+	statistics->queueSize(size());
 }
 
 void
@@ -91,14 +96,12 @@ EventQueue::
 process_pending_updates() {
 
 	for (auto t : need_dropping) {
-		assert(t);
-		drop_by_tidx(t->mainEdge );
+		drop_by_tidx(t);
 	}
 	need_dropping.clear();
 
 	for (auto t : need_update) {
-		assert(t);
-		update_by_tidx(t->mainEdge);
+		update_by_tidx(t);
 	}
 	need_update.clear();
 
@@ -120,28 +123,27 @@ assert_no_pending() const {
  */
 void
 EventQueue::
-needs_update(const Event * t, bool may_have_valid_collapse_spec) {
-	assert(tidx_in_need_update.size() > t->mainEdge);
-	if (! tidx_in_need_update[t->mainEdge]) {
-		tidx_in_need_update[t->mainEdge ] = true;
-		need_update.push_back(t);
-		auto ubm = need_update.back();
+needs_update(unsigned tidx, bool may_have_valid_collapse_spec) {
+	assert(tidx_in_need_update.size() > tidx);
+	if (! tidx_in_need_update[tidx]) {
+		tidx_in_need_update[tidx] = true;
+		need_update.push_back(tidx);
 	}
 
-	assert(!tidx_in_need_dropping[t->mainEdge]); /* Can't drop and update both */
+	assert(!tidx_in_need_dropping[tidx]); /* Can't drop and update both */
 }
 
 void
 EventQueue::
-needs_dropping(Event * t) {
-	assert(tidx_in_need_dropping.size() > t->mainEdge);
+needs_dropping(unsigned tidx) {
+	assert(tidx_in_need_dropping.size() > tidx);
 
-	assert(!tidx_in_need_dropping[t->mainEdge]);
-	tidx_in_need_dropping[t->mainEdge] = true;
+	assert(!tidx_in_need_dropping[tidx]);
+	tidx_in_need_dropping[tidx] = true;
 
-	need_dropping.push_back(t);
+	need_dropping.push_back(tidx);
 
-	assert(!tidx_in_need_update[t->mainEdge]); /* Can't drop and update both */
+	assert(!tidx_in_need_update[tidx]); /* Can't drop and update both */
 }
 
 bool
@@ -152,8 +154,8 @@ in_needs_update(const ul edgeIdx) const {
 
 bool
 EventQueue::
-in_needs_dropping(const Event * t) const {
-	return tidx_in_need_dropping[t->mainEdge];
+in_needs_dropping(const ul edgeIdx) const {
+	return tidx_in_need_dropping[edgeIdx];
 }
 
 /** checks whether the heap satisfies the heap property.
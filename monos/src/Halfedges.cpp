@@ -0,0 +1,108 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Halfedges.h"
+
+#include <algorithm>
+
+ul Halfedges::build(const Data& data, const Nodes& nodes, const ArcList& arcList) {
+	const auto& polygon = data.getPolygon();
+	numArcs = arcList.size();
+	const ul n = 2 * (numArcs + polygon.size());
+
+	origins.assign(n,MAX);
+	faces.assign(n,MAX);
+	nexts.assign(n,MAX);
+	prevs.assign(n,MAX);
+
+	/* a ray has no second node and stays unconnected */
+	for(const auto& arc : arcList) {
+		if(!arc.isEdge()) {continue;}
+		origins[2 * arc.id]     = arc.firstNodeIdx;
+		origins[2 * arc.id + 1] = arc.secondNodeIdx;
+		faces[2 * arc.id]       = arc.leftEdgeIdx;
+		faces[2 * arc.id + 1]   = arc.rightEdgeIdx;
+	}
+	for(const auto& e : polygon) {
+		origins[faceHalfedge(e.id)]     = e.u;
+		origins[faceHalfedge(e.id) + 1] = e.v;
+		faces[faceHalfedge(e.id)]       = e.id;
+	}
+
+	/* the half-edges leaving every node, in CSR form */
+	std::vector<ul> offsets(nodes.size() + 1,0), outgoing(n);
+	for(ul h = 0; h < n; ++h) {
+		if(origins[h] != MAX) {++offsets[origins[h] + 1];}
+	}
+	for(ul i = 0; i < nodes.size(); ++i) {offsets[i + 1] += offsets[i];}
+	std::vector<ul> fill(offsets.begin(),offsets.end() - 1);
+	for(ul h = 0; h < n; ++h) {
+		if(origins[h] != MAX) {outgoing[fill[origins[h]]++] = h;}
+	}
+
+	/* the face continues on the half-edge leaving the target in the same face;
+	 * only the outside and the plateau may pass a node more than once */
+	ul open = 0;
+	std::vector<ul> candidates;
+	for(ul h = 0; h < n; ++h) {
+		if(origins[h] == MAX) {continue;}
+		const ul at = target(h);
+		candidates.clear();
+		for(ul i = offsets[at]; i < offsets[at + 1]; ++i) {
+			const ul g = outgoing[i];
+			if(g != twin(h) && faces[g] == faces[h]) {candidates.push_back(g);}
+		}
+		if(candidates.empty()) {
+			++open;
+			continue;
+		}
+		nexts[h] = (candidates.size() == 1) ? candidates.front() : firstClockwise(nodes,h,candidates);
+		prevs[nexts[h]] = h;
+	}
+
+	if(open > 0) {
+		LOG(WARNING) << "half-edges: " << open << " without a next one";
+	}
+	return open;
+}
+
+ul Halfedges::firstClockwise(const Nodes& nodes, const ul& h, const std::vector<ul>& candidates) const {
+	const Point& at = nodes[target(h)].point;
+	const Vector r  = nodes[origin(h)].point - at;
+
+	auto cross = [](const Vector& a, const Vector& b) {return a.x() * b.y() - a.y() * b.x();};
+	auto dot   = [](const Vector& a, const Vector& b) {return a.x() * b.x() + a.y() * b.y();};
+	/* 0 for a clockwise turn of less than pi from r, 1 for pi or more */
+	auto half  = [&](const Vector& a) {
+		const NT c = cross(r,a);
+		return (c < NT(0)) ? 0 : ((c > NT(0) || dot(r,a) < NT(0)) ? 1 : 2);
+	};
+
+	ul best = candidates.front();
+	Vector b = nodes[target(best)].point - at;
+	for(auto it = candidates.begin() + 1; it != candidates.end(); ++it) {
+		const Vector a = nodes[target(*it)].point - at;
+		const int ha = half(a), hb = half(b);
+		if(ha < hb || (ha == hb && cross(a,b) < NT(0))) {
+			best = *it;
+			b = a;
+		}
+	}
+	return best;
+}
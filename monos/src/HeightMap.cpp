@@ -0,0 +1,150 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "HeightMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <thread>
+
+HeightMap::HeightMap(const Data& _data, const Wavefront& _wf, const unsigned _width, const unsigned _height):
+	heights(static_cast<std::size_t>(_width) * _height,0.0f),
+	width(_width), height(_height), data(_data) {
+
+	const BBox& box = *data.bbox;
+	xMin = toDouble(box.xMin.p.x());
+	yMax = toDouble(box.yMax.p.y());
+	pixelWidth  = (toDouble(box.xMax.p.x()) - xMin) / width;
+	pixelHeight = (yMax - toDouble(box.yMin.p.y())) / height;
+	plateau = (_wf.isBounded()) ? toDouble(_wf.maxOffset) : 0.0;
+
+	std::vector<double> px, py;
+	px.reserve(_wf.nodes.size());
+	py.reserve(_wf.nodes.size());
+	for(const auto& node : _wf.nodes) {
+		px.push_back(toDouble(node.point.x()));
+		py.push_back(toDouble(node.point.y()));
+	}
+
+	/* going up, the right face of an arc is its right one, going down its
+	 * left one; the polygon has its interior left of its edges. The side of a
+	 * front without a face is the plateau */
+	auto add = [&](const ul& a, const ul& b, const ul& faceLeft, const ul& faceRight) {
+		if(py[a] < py[b]) {
+			segments.push_back({px[a],py[a],py[b],(px[b] - px[a]) / (py[b] - py[a]),faceRight});
+		} else if(py[b] < py[a]) {
+			segments.push_back({px[b],py[b],py[a],(px[a] - px[b]) / (py[a] - py[b]),faceLeft});
+		}
+	};
+	segments.reserve(_wf.arcList.size() + data.getPolygon().size());
+	for(const auto& arc : _wf.arcList) {
+		if(!arc.isEdge()) {continue;}
+		add(arc.firstNodeIdx,arc.secondNodeIdx,
+			(arc.leftEdgeIdx  != MAX) ? arc.leftEdgeIdx  : PLATEAU,
+			(arc.rightEdgeIdx != MAX) ? arc.rightEdgeIdx : PLATEAU);
+	}
+	for(const auto& e : data.getPolygon()) {
+		add(e.u,e.v,e.id,MAX);
+	}
+}
+
+void HeightMap::rasterize(unsigned threads) {
+	if(width == 0 || height == 0) {return;}
+	if(threads == 0) {threads = std::max(1u,std::thread::hardware_concurrency());}
+	threads = std::min(threads,height);
+
+	const unsigned band = (height + threads - 1) / threads;
+	std::vector<std::thread> workers;
+	for(unsigned first = 0; first < height; first += band) {
+		workers.emplace_back(&HeightMap::rasterizeRows,this,first,std::min(first + band,height));
+	}
+	for(auto& w : workers) {w.join();}
+}
+
+/* rows [firstRow,lastRow) from top to bottom, a segment is active in a row
+ * if y0 <= y < y1 at its center, thus a vertex is crossed once. Segments do
+ * not cross, the active ones stay ordered by x from row to row and only the
+ * ones starting in a row are merged in */
+void HeightMap::rasterizeRows(const unsigned firstRow, const unsigned lastRow) {
+	const double yTop    = yMax - firstRow * pixelHeight;
+	const double yBottom = yMax - lastRow  * pixelHeight;
+
+	std::vector<const Crossing*> candidates;
+	for(const auto& s : segments) {
+		if(s.y1 >= yBottom && s.y0 <= yTop) {candidates.push_back(&s);}
+	}
+	std::sort(candidates.begin(),candidates.end(),[](const Crossing* a, const Crossing* b) {return a->y1 > b->y1;});
+
+	/* x in the row and the segment; at the same x ordered as just above the row */
+	using Key = std::pair<double,const Crossing*>;
+	auto less = [](const Key& a, const Key& b) {
+		return a.first < b.first || (a.first == b.first && a.second->dxdy < b.second->dxdy);
+	};
+	std::vector<Key> active, fresh, merged;
+
+	auto next = candidates.begin();
+	for(unsigned j = firstRow; j < lastRow; ++j) {
+		const double y = yMax - (j + 0.5) * pixelHeight;
+
+		merged.clear();
+		for(const auto& a : active) {
+			if(y >= a.second->y0) {merged.emplace_back(a.second->x0 + (y - a.second->y0) * a.second->dxdy, a.second);}
+		}
+		fresh.clear();
+		for(; next != candidates.end() && (*next)->y1 > y; ++next) {
+			if(y >= (*next)->y0) {fresh.emplace_back((*next)->x0 + (y - (*next)->y0) * (*next)->dxdy, *next);}
+		}
+		std::sort(fresh.begin(),fresh.end(),less);
+		active.resize(merged.size() + fresh.size());
+		std::merge(merged.begin(),merged.end(),fresh.begin(),fresh.end(),active.begin(),less);
+
+		float* row = heights.data() + static_cast<std::size_t>(j) * width;
+		for(std::size_t k = 0; k + 1 < active.size(); ++k) {
+			const ul face = active[k].second->face;
+			if(face == MAX) {continue;}
+
+			/* the pixels with their center in [x_k,x_k+1) */
+			const long first = std::max(0L,static_cast<long>(std::ceil((active[k].first   - xMin) / pixelWidth - 0.5)));
+			const long last  = std::min(static_cast<long>(width),
+										static_cast<long>(std::ceil((active[k+1].first - xMin) / pixelWidth - 0.5)));
+			if(first >= last) {continue;}
+			if(face == PLATEAU) {
+				std::fill(row + first, row + last, static_cast<float>(plateau));
+				continue;
+			}
+			for(long i = first; i < last; ++i) {
+				row[i] = static_cast<float>(data.signedDistance(face, xMin + (i + 0.5) * pixelWidth, y));
+			}
+		}
+	}
+}
+
+bool HeightMap::writePFM(const std::string& fileName) const {
+	std::ofstream out(fileName,std::ofstream::binary);
+	if(!out) {return false;}
+
+	/* a negative scale marks little endian data */
+	out << "Pf\n" << width << " " << height << "\n-1.0\n";
+	for(unsigned j = height; j > 0; --j) {
+		out.write(reinterpret_cast<const char*>(heights.data() + static_cast<std::size_t>(j - 1) * width),
+				  static_cast<std::streamsize>(width) * sizeof(float));
+	}
+	return out.good();
+}
@@ -30,25 +30,57 @@
 #include "Data.h"
 #include "BGLGraph.h"
 #include "BasicInput.h"
+#include "PolygonFile.h"
+#include "Offsets.h"
+#include "PointLocation.h"
+#include "HeightMap.h"
+#include "Profile.h"
 
 #include "EventQueue.h"
+#include "Trace.h"
 #include <random>
 
 Monos::Monos(const Config& cfg):config(cfg) {}
 
 Monos::~Monos() {
-	delete data;
-	delete wf;
 	delete s;
+	delete wf;
+	delete data;
+
+	/* everything of the run is released in one step */
+	if(arena != nullptr) {
+		double time_spent = arena->release();
+		if(config.timings && config.verbose) {
+			LOG(INFO) << "arena release: " << time_spent << " seconds";
+		}
+		delete arena;
+	}
+}
+
+/* generous estimate of the memory a run needs (nodes, arcs, path finder, queue
+ * items, the final adjacency and half-edges per edge), the arena grows if it is not */
+static std::size_t arenaSizeHint(const std::size_t n) {
+	return n * (3 * sizeof(Node) + 3 * sizeof(Arc) + sizeof(EndNodes)
+			  + 4 * sizeof(EventQueueItem) + 40 * sizeof(ul) + 64) + 4096;
 }
 
 
 bool Monos::readInput() {
 	std::ifstream in;
 	if(fileExists(config.fileName)) {
-		in.open(config.fileName);
-		BGLGraph gml = BGLGraph::create_from_graphml(in);
+		in.open(config.fileName, std::ios::binary);
 		input = BasicInput();
+
+		/* binary polygons are recognized by their magic, all else is GraphML */
+		polygonfile::Header header = {};
+		in.read(reinterpret_cast<char*>(&header),sizeof(header));
+		in.clear();
+		in.seekg(0);
+		if(polygonfile::isValid(header)) {
+			return input.add_polygon(in);
+		}
+
+		BGLGraph gml = BGLGraph::create_from_graphml(in);
 		input.add_graph(gml);
 		return true;
 	}
@@ -57,33 +89,59 @@ bool Monos::readInput() {
 
 
 void Monos::run() {
-	clock_t begin, end;
-
-	if(!readInput()) {return;}
+	if(config.perfCounters) {
+		if(perf.open()) {
+			timings.setPerfCounters(&perf);
+		} else {
+			LOG(WARNING) << "no hardware counters, the report goes without (" << perf.error() << ")";
+		}
+	}
 
-	/****************** TIMING START ******************************/
-	if(config.timings) {begin = clock();}
+	{
+		Timings::Scope phase(timings,Phase::READ);
+		if(!readInput()) {return;}
+	}
 
 	/**************************************************************/
 	/*				MONOTONE SKELETON APPROACH 					  */
 	/**************************************************************/
 
-	if(!init()) {return;}
+	{
+		Timings::Scope phase(timings,Phase::DECOMPOSE);
+		if(!init()) {return;}
+	}
 
-	if(!wf->ComputeSkeleton(ChainType::LOWER)) {return;}
+	{
+		Timings::Scope phase(timings,Phase::LOWER_CHAIN);
+		if(!wf->ComputeSkeleton(ChainType::LOWER)) {return;}
+	}
 	if(config.verbose) {LOG(INFO) << "lower skeleton done";}
 
-	if(!wf->ComputeSkeleton(ChainType::UPPER)) {return;}
+	{
+		Timings::Scope phase(timings,Phase::UPPER_CHAIN);
+		if(!wf->ComputeSkeleton(ChainType::UPPER)) {return;}
+	}
 	if(config.verbose) {LOG(INFO) << "upper skeleton done";}
 
-	s->MergeUpperLowerSkeleton();
+	{
+		Timings::Scope phase(timings,Phase::MERGE);
+		s->MergeUpperLowerSkeleton();
+	}
 	if(config.verbose) {LOG(INFO) << "merging upper and lower skeleton done";}
 
+	{
+		Timings::Scope phase(timings,Phase::WRITE);
+		write();
+	}
 
-	/****************** TIMING END ********************************/
-	if(config.timings) {end = clock();}
-
-	write();
+	if(!config.traceFileName.empty()) {
+		if(MONOS_TRACE == 0) {
+			LOG(WARNING) << "no trace categories compiled in, see TRACE_CATEGORIES";
+		}
+		if(!trace::ring.dump(config.traceFileName)) {
+			LOG(ERROR) << "could not write trace to " << config.traceFileName;
+		}
+	}
 
 	if(config.timings) {
 		struct rusage usage;
@@ -91,11 +149,18 @@ void Monos::run() {
 			LOG(ERROR) << "getrusage() failed: " << strerror(errno);
 			exit(1);
 		}
-		double time_spent = 0.0 + (double)(end - begin) / CLOCKS_PER_SEC;
+		/* the computation, i.e., without reading and writing */
+		double time_spent = timings.sum(Phase::DECOMPOSE,Phase::COMPACTION).cpu;
 		if(config.verbose) {
 			LOG(INFO) << "number of vertices: " << data->getPolygon().size();
 			LOG(INFO) << "time spent: " << time_spent << " seconds";
 			LOG(INFO) << "mem usage : " << usage.ru_maxrss << " kB";
+			LOG(INFO) << "arena     : " << arena->allocations << " allocations, "
+					  << arena->bytes << " bytes, "
+					  << arena->systemAllocations() << " system allocations, "
+					  << arena->systemBytes() << " bytes reserved"
+					  << (arena->usesHugePages() ? " (huge pages)" : "");
+			LOG(INFO) << "statistics: " << statistics;
 			LOG(INFO) << "filename: " << config.fileName;
 		} else {
 			std::cout << data->getPolygon().size()
@@ -103,6 +168,17 @@ void Monos::run() {
 					  << "," << usage.ru_maxrss
 					  << "," << config.fileName
 					  << std::endl;
+			/* stdout stays a single CSV line */
+			std::cerr << "statistics: " << statistics << std::endl;
+		}
+	}
+
+	if(!config.reportFileName.empty()) {
+		if(config.reportFileName == "-") {
+			timings.writeJSON(std::cout,config.fileName,data->getPolygon().size(),&statistics);
+		} else {
+			std::ofstream report(config.reportFileName);
+			timings.writeJSON(report,config.fileName,data->getPolygon().size(),&statistics);
 		}
 	}
 }
@@ -110,14 +186,78 @@ void Monos::run() {
 void Monos::write() {
 	if( s->computationFinished ) {
 		s->writeOBJ(config);
-		data->addPolyToOBJ(config);
 		if(config.verbose) {LOG(INFO) << "output written";}
+
+		if(!config.binaryFileName.empty()) {
+			if(!s->writeBinary(config)) {
+				LOG(ERROR) << "could not write binary skeleton to " << config.binaryFileName;
+			} else if(config.verbose) {
+				LOG(INFO) << "binary skeleton written";
+			}
+		}
+
+		if(!config.offsetsFileName.empty()) {
+			if(wf->isBounded() && config.offsets.back() >= toDouble(wf->maxOffset)) {
+				LOG(WARNING) << "offsets from --max-time on are empty";
+			}
+			Offsets offsets(*data,*wf);
+			offsets.writeOBJ(config,offsets.extract(std::vector<NT>(config.offsets.begin(),config.offsets.end())));
+			if(config.verbose) {LOG(INFO) << "offsets written";}
+		}
+
+		if(!config.locatedFileName.empty()) {
+			locatePoints();
+		}
+
+		if(!config.rasterFileName.empty()) {
+			HeightMap map(*data,*wf,config.rasterWidth,config.rasterHeight);
+			map.rasterize();
+			if(!map.writePFM(config.rasterFileName)) {
+				LOG(ERROR) << "could not write height map to " << config.rasterFileName;
+			} else if(config.verbose) {
+				LOG(INFO) << "height map written";
+			}
+		}
+
+		if(!config.profileFileName.empty()) {
+			Profile profile(*data,*wf);
+			profile.write(config);
+			if(config.verbose) {LOG(INFO) << "profile written, volume " << profile.volume();}
+		}
+	}
+}
+
+/* the face and roof height of every query point, one 'x y' per line */
+void Monos::locatePoints() {
+	std::ifstream in(config.locateFileName);
+	if(!in) {
+		LOG(ERROR) << "could not read query points from " << config.locateFileName;
+		return;
+	}
+	std::vector<double> xs, ys;
+	double x, y;
+	while(in >> x >> y) {
+		xs.push_back(x);
+		ys.push_back(y);
+	}
+
+	PointLocation index(*data,*wf);
+	std::vector<ul> faces(xs.size());
+	std::vector<double> heights(xs.size());
+	index.locate(xs.data(),ys.data(),xs.size(),faces.data(),heights.data());
+
+	std::ofstream out(config.locatedFileName,std::ofstream::binary);
+	out.precision(std::numeric_limits<double>::max_digits10);
+	for(ul i = 0; i < faces.size(); ++i) {
+		out << ((faces[i] != MAX) ? static_cast<sl>(faces[i]) : NIL) << " " << heights[i] << "\n";
 	}
+	if(config.verbose) {LOG(INFO) << xs.size() << " points located";}
 }
 
 
 bool Monos::init() {
-	data = new Data(input);
+	arena = new Arena(arenaSizeHint(input.edges().size()), config.hugePages);
+	data  = new Data(input, *arena, timings, statistics);
 
 	/* verify monotonicity and compute monotonicity line */
 	if(config.not_x_mon) {
@@ -134,6 +274,8 @@ bool Monos::init() {
 	wf = new Wavefront(*data);
 	s  = new Skeleton(*data,*wf);
 
+	if(config.maxOffset > 0.0) {wf->setMaxTime(NT(config.maxOffset));}
+
 
 	/* debug */
 	if(config.verbose) {LOG(INFO) << "monotonicity line: " << data->monotonicityLine.to_vector();}
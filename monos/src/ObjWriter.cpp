@@ -0,0 +1,110 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ObjWriter.h"
+
+#include <algorithm>
+#include <thread>
+
+/* 'v x y z\n' at out, returns the end of the line */
+static char* formatVertex(char* out, char* last, const double x, const double y, const double z) {
+	*out++ = 'v';
+	for(const double c : {x,y,z}) {
+		*out++ = ' ';
+		out = std::to_chars(out,last,c).ptr;
+	}
+	*out++ = '\n';
+	return out;
+}
+
+ObjWriter::ObjWriter(const std::string& fileName, const std::size_t capacity):
+	file(std::fopen(fileName.c_str(),"wb")), buffer(std::max(capacity,VERTEX_LINE)) {
+	/* the buffer above is the only one */
+	if(file != nullptr) {std::setvbuf(file,nullptr,_IONBF,0);}
+}
+
+ObjWriter::~ObjWriter() {
+	if(file != nullptr) {
+		flush();
+		std::fclose(file);
+	}
+}
+
+void ObjWriter::flush() {
+	write(buffer.data(),used);
+	used = 0;
+}
+
+void ObjWriter::write(const char* data, const std::size_t size) {
+	if(file == nullptr || size == 0) {return;}
+	if(std::fwrite(data,1,size,file) != size) {failed = true;}
+}
+
+void ObjWriter::comment(const std::string& text) {
+	if(used + text.size() + 3 > buffer.size()) {
+		flush();
+		if(text.size() + 3 > buffer.size()) {
+			write("# ",2);
+			write(text.data(),text.size());
+			write("\n",1);
+			return;
+		}
+	}
+	put('#');
+	put(' ');
+	std::copy(text.begin(),text.end(),buffer.data() + used);
+	used += text.size();
+	put('\n');
+}
+
+void ObjWriter::vertex(const double x, const double y, const double z) {
+	reserve(VERTEX_LINE);
+	used = formatVertex(buffer.data() + used,buffer.data() + buffer.size(),x,y,z) - buffer.data();
+}
+
+void ObjWriter::vertices(const double* xs, const double* ys, const double* zs, const ul n, unsigned threads) {
+	if(threads == 0) {threads = std::max(1u,std::thread::hardware_concurrency());}
+	threads = static_cast<unsigned>(std::min<ul>(threads,n / PARALLEL_VERTICES));
+
+	if(threads < 2) {
+		for(ul i = 0; i < n; ++i) {vertex(xs[i],ys[i],zs[i]);}
+		return;
+	}
+
+	/* every thread formats a band of vertices into its own part */
+	const ul band = (n + threads - 1) / threads;
+	std::vector<std::vector<char>> parts(threads);
+	std::vector<std::thread> workers;
+	for(unsigned t = 0; t < threads; ++t) {
+		workers.emplace_back([&,t]() {
+			const ul first = t * band, last = std::min(first + band,n);
+			auto& part = parts[t];
+			part.resize((last - first) * VERTEX_LINE);
+			char* out = part.data();
+			for(ul i = first; i < last; ++i) {
+				out = formatVertex(out,part.data() + part.size(),xs[i],ys[i],zs[i]);
+			}
+			part.resize(out - part.data());
+		});
+	}
+	for(auto& w : workers) {w.join();}
+
+	flush();
+	for(const auto& part : parts) {write(part.data(),part.size());}
+}
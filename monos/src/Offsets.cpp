@@ -0,0 +1,184 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Offsets.h"
+
+#include "ObjWriter.h"
+
+Offsets::Offsets(const Data& _data, const Wavefront& _wf):
+	data(_data), wf(_wf),
+	leftPosition(_wf.arcList.size(),MAX), rightPosition(_wf.arcList.size(),MAX),
+	order(_wf.nodes.size()), rank(_wf.nodes.size()),
+	next(_wf.arcList.size(),MAX) {
+
+	distance.reserve(wf.nodes.size());
+	for(const auto& node : wf.nodes) {
+		distance.push_back(squareRoot(node.time));
+	}
+
+	/* equal times are ordered by index, thus every arc has a lower and an upper node */
+	for(ul i = 0; i < order.size(); ++i) {order[i] = i;}
+	std::sort(order.begin(),order.end(),[&](const ul& a, const ul& b) {
+		return wf.nodes[a].time < wf.nodes[b].time || (wf.nodes[a].time == wf.nodes[b].time && a < b);
+	});
+	for(ul i = 0; i < order.size(); ++i) {rank[order[i]] = i;}
+
+	for(ul edgeIdx = 0; edgeIdx < data.getPolygon().size(); ++edgeIdx) {
+		walkFace(edgeIdx);
+	}
+}
+
+/* number the arcs along the boundary of the face of an edge, its half-edge
+ * cycle leaves the polygon edge at the right (v) vertex */
+void Offsets::walkFace(const ul& edgeIdx) {
+	const auto& he = wf.halfedges;
+	const ul first = he.faceHalfedge(edgeIdx);
+	ul h = he.next(first), position = 0;
+
+	while(h != first) {
+		if(h == MAX || he.arc(h) == MAX || position > wf.arcList.size()) {
+			LOG(WARNING) << "offsets: face of edge " << edgeIdx << " is not closed";
+			return;
+		}
+
+		/* the even half-edge of an arc lies in its left face */
+		if(h % 2 == 0) {
+			leftPosition[he.arc(h)]  = position++;
+		} else {
+			rightPosition[he.arc(h)] = position++;
+		}
+		h = he.next(h);
+	}
+}
+
+/* the sweep passes a node: its arcs to upper nodes start, the others end */
+void Offsets::addNode(const ul& nodeIdx) {
+	for(auto it = wf.adjacency.begin(nodeIdx); it != wf.adjacency.end(nodeIdx); ++it) {
+		const Arc& arc = wf.arcList[*it];
+		if(!arc.isEdge()) {continue;}
+
+		const bool starts = rank[arc.getSecondNodeIdx(nodeIdx)] > rank[nodeIdx];
+		for(auto side : {std::make_pair(arc.leftEdgeIdx,leftPosition[*it]), std::make_pair(arc.rightEdgeIdx,rightPosition[*it])}) {
+			if(side.first == MAX || side.second == MAX) {continue;}
+			if(starts) {
+				active.emplace(side,*it);
+			} else {
+				active.erase(side);
+			}
+		}
+	}
+}
+
+std::vector<Offsets::Curve> Offsets::extract(const std::vector<NT>& offsets) {
+	assert(std::is_sorted(offsets.begin(),offsets.end()));
+
+	std::vector<Curve> curves;
+	curves.reserve(offsets.size());
+
+	ul i = 0;
+	for(const auto& offset : offsets) {
+		const NT time = offset * offset;
+		while(i < order.size() && wf.nodes[order[i]].time <= time) {
+			addNode(order[i++]);
+		}
+		curves.push_back({offset,{}});
+		emit(curves.back());
+	}
+	return curves;
+}
+
+void Offsets::emit(Curve& curve) {
+	for(const auto& a : active) {next[a.second] = MAX;}
+
+	/* along the boundary of a face the first crossing of a pair is where the
+	 * curve leaves the face, the second where it enters it */
+	for(auto it = active.begin(); it != active.end(); ) {
+		auto leave = it++;
+		if(it == active.end() || it->first.first != leave->first.first) {
+			LOG(WARNING) << "offset " << curve.offset << " crosses the face of edge "
+						 << leave->first.first << " an odd number of times";
+			continue;
+		}
+		next[it->second] = leave->second;
+		++it;
+	}
+
+	for(const auto& a : active) {
+		ul arcIdx = a.second;
+		if(next[arcIdx] == MAX) {continue;}
+
+		std::vector<Point> polygon;
+		while(next[arcIdx] != MAX) {
+			Point P = crossing(wf.arcList[arcIdx],curve.offset);
+			/* arcs starting at a node of this very offset cross it in the same point */
+			if(polygon.empty() || polygon.back() != P) {polygon.push_back(P);}
+			const ul nextArcIdx = next[arcIdx];
+			next[arcIdx] = MAX;
+			arcIdx = nextArcIdx;
+		}
+		if(polygon.size() > 1 && polygon.back() == polygon.front()) {polygon.pop_back();}
+		curve.polygons.push_back(std::move(polygon));
+	}
+}
+
+Point Offsets::crossing(const Arc& arc, const NT& offset) const {
+	ul lowerIdx = arc.firstNodeIdx, upperIdx = arc.secondNodeIdx;
+	if(rank[lowerIdx] > rank[upperIdx]) {std::swap(lowerIdx,upperIdx);}
+
+	const Point& A = wf.nodes[lowerIdx].point;
+	const Point& B = wf.nodes[upperIdx].point;
+	const NT lambda = (offset - distance[lowerIdx]) / (distance[upperIdx] - distance[lowerIdx]);
+	return A + (B - A) * lambda;
+}
+
+void Offsets::writeOBJ(const Config& cfg, const std::vector<Curve>& curves) const {
+	double xt = 0.0, yt = 0.0, zt = 0.0, xm = 1.0, ym = 1.0, zm = 1.0;
+	if(cfg.normalize) {
+		getNormalizer(*data.bbox,xt,xm,yt,ym,zt,zm);
+		zm = 0.1;
+	} else {
+		xm = 1.0/OBJSCALE;
+		ym = 1.0/OBJSCALE;
+	}
+	zm /= OBJSCALE;
+
+	ObjWriter out(cfg.offsetsFileName);
+	out.comment("OBJ-File autogenerated by monos from file (" + cfg.fileName + ") - offsets - " + currentTimeStamp());
+
+	ul vertexIdx = 0;
+	for(const auto& curve : curves) {
+		out.comment("offset " + std::to_string(toDouble(curve.offset)) + ", " + std::to_string(curve.polygons.size()) + " polygons");
+		const double z = toDouble(curve.offset) * zm;
+		for(const auto& polygon : curve.polygons) {
+			for(const auto& P : polygon) {
+				out.vertex((toDouble(P.x()) - xt) * xm, (toDouble(P.y()) - yt) * ym, z);
+			}
+			out.begin('l');
+			for(ul i = 0; i < polygon.size(); ++i) {
+				out.index(vertexIdx + i);
+			}
+			out.index(vertexIdx);
+			out.end();
+			vertexIdx += polygon.size();
+		}
+	}
+
+	out.flush();
+	if(!out.good()) {LOG(ERROR) << "could not write " << cfg.offsetsFileName;}
+}
@@ -0,0 +1,107 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const char* counterNames[] = {
+	"cycles", "instructions", "cache_references", "cache_misses", "branches", "branch_misses"
+};
+
+const char* PerfCounters::name(HwCounter c) {
+	return counterNames[static_cast<unsigned>(c)];
+}
+
+bool PerfCounters::available() const {
+	for(int fd : fds) {
+		if(fd >= 0) {return true;}
+	}
+	return false;
+}
+
+#ifdef __linux__
+
+static const uint64_t counterConfigs[] = {
+	PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+	PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES,
+	PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES
+};
+
+PerfCounters::~PerfCounters() {
+	for(int fd : fds) {
+		if(fd >= 0) {close(fd);}
+	}
+}
+
+bool PerfCounters::open() {
+	for(unsigned i = 0; i < NUM; ++i) {
+		if(fds[i] >= 0) {continue;}
+
+		struct perf_event_attr attr;
+		memset(&attr,0,sizeof(attr));
+		attr.size           = sizeof(attr);
+		attr.type           = PERF_TYPE_HARDWARE;
+		attr.config         = counterConfigs[i];
+		attr.exclude_kernel = 1;
+		attr.exclude_hv     = 1;
+		attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		/* this process, any cpu, no group */
+		fds[i] = static_cast<int>(syscall(SYS_perf_event_open,&attr,0,-1,-1,PERF_FLAG_FD_CLOEXEC));
+		if(fds[i] < 0) {
+			lastError = std::string(counterNames[i]) + ": " + strerror(errno);
+		}
+	}
+	return available();
+}
+
+PerfCounters::Values PerfCounters::read() const {
+	Values values = {};
+	for(unsigned i = 0; i < NUM; ++i) {
+		if(fds[i] < 0) {continue;}
+		uint64_t buffer[3];	/* value, time enabled, time running */
+		if(::read(fds[i],buffer,sizeof(buffer)) != sizeof(buffer) || buffer[2] == 0) {continue;}
+		values[i] = (buffer[1] == buffer[2]) ? buffer[0]
+				  : static_cast<uint64_t>(static_cast<double>(buffer[0]) * buffer[1] / buffer[2]);
+	}
+	return values;
+}
+
+#else
+
+PerfCounters::~PerfCounters() {}
+
+bool PerfCounters::open() {
+	lastError = "hardware counters need Linux (perf_event_open)";
+	return false;
+}
+
+PerfCounters::Values PerfCounters::read() const {
+	return {};
+}
+
+#endif
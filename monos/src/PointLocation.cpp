@@ -0,0 +1,170 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PointLocation.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+/* a non-vertical segment from left to right and the face above it */
+struct Slab {
+	double x0, y0, x1, y1;
+	ul face;
+};
+}
+
+PointLocation::PointLocation(const Data& _data, const Wavefront& _wf): data(_data) {
+	std::vector<double> px, py;
+	px.reserve(_wf.nodes.size());
+	py.reserve(_wf.nodes.size());
+	for(const auto& node : _wf.nodes) {
+		px.push_back(toDouble(node.point.x()));
+		py.push_back(toDouble(node.point.y()));
+	}
+
+	/* an arc has its left face above if it points to the right, the polygon
+	 * has its interior left of its edges; vertical segments separate nothing */
+	std::vector<Slab> segments;
+	segments.reserve(_wf.arcList.size() + data.getPolygon().size());
+	auto add = [&](const ul& a, const ul& b, const ul& faceLeft, const ul& faceRight) {
+		if(px[a] < px[b]) {
+			segments.push_back({px[a],py[a],px[b],py[b],faceLeft});
+		} else if(px[b] < px[a]) {
+			segments.push_back({px[b],py[b],px[a],py[a],faceRight});
+		}
+	};
+	for(const auto& arc : _wf.arcList) {
+		if(arc.isEdge()) {add(arc.firstNodeIdx,arc.secondNodeIdx,arc.leftEdgeIdx,arc.rightEdgeIdx);}
+	}
+	for(const auto& e : data.getPolygon()) {
+		add(e.u,e.v,e.id,MAX);
+	}
+
+	xs.reserve(2 * segments.size());
+	for(const auto& s : segments) {
+		xs.push_back(s.x0);
+		xs.push_back(s.x1);
+	}
+	std::sort(xs.begin(),xs.end());
+	xs.erase(std::unique(xs.begin(),xs.end()),xs.end());
+	if(xs.size() < 2) {return;}
+
+	/* leaves are the elementary intervals, node i has children 2i and 2i+1 */
+	numLeaves = 1;
+	while(numLeaves < xs.size() - 1) {numLeaves *= 2;}
+
+	std::vector<double> nodeLeft(2 * numLeaves), nodeRight(2 * numLeaves);
+	for(std::size_t i = 0; i < numLeaves; ++i) {
+		nodeLeft[numLeaves + i]  = xs[std::min(i,xs.size() - 1)];
+		nodeRight[numLeaves + i] = xs[std::min(i + 1,xs.size() - 1)];
+	}
+	for(std::size_t i = numLeaves - 1; i > 0; --i) {
+		nodeLeft[i]  = nodeLeft[2*i];
+		nodeRight[i] = nodeRight[2*i+1];
+	}
+	nodeMidX.resize(2 * numLeaves);
+	for(std::size_t i = 1; i < 2 * numLeaves; ++i) {
+		nodeMidX[i] = 0.5 * (nodeLeft[i] + nodeRight[i]);
+	}
+
+	/* the canonical nodes covering the leaves [first,last) of a segment */
+	auto forNodes = [&](const Slab& s, auto&& f) {
+		std::size_t first = std::lower_bound(xs.begin(),xs.end(),s.x0) - xs.begin() + numLeaves;
+		std::size_t last  = std::lower_bound(xs.begin(),xs.end(),s.x1) - xs.begin() + numLeaves;
+		for(; first < last; first /= 2, last /= 2) {
+			if(first & 1) {f(first++);}
+			if(last & 1)  {f(--last);}
+		}
+	};
+
+	nodeOffsets.assign(2 * numLeaves + 1,0);
+	for(const auto& s : segments) {
+		forNodes(s,[&](std::size_t nodeIdx) {++nodeOffsets[nodeIdx+1];});
+	}
+	std::partial_sum(nodeOffsets.begin(),nodeOffsets.end(),nodeOffsets.begin());
+
+	const std::size_t numEntries = nodeOffsets.back();
+	midY.resize(numEntries);
+	slope.resize(numEntries);
+	faceAbove.resize(numEntries);
+	std::vector<std::size_t> fill(nodeOffsets.begin(),nodeOffsets.end() - 1);
+	for(const auto& s : segments) {
+		const double m = (s.y1 - s.y0) / (s.x1 - s.x0);
+		forNodes(s,[&](std::size_t nodeIdx) {
+			const std::size_t i = fill[nodeIdx]++;
+			midY[i]      = s.y0 + m * (nodeMidX[nodeIdx] - s.x0);
+			slope[i]     = m;
+			faceAbove[i] = s.face;
+		});
+	}
+
+	/* the segments of a node span its x-range and do not cross, ordered by y */
+	std::vector<std::size_t> perm;
+	for(std::size_t nodeIdx = 1; nodeIdx < 2 * numLeaves; ++nodeIdx) {
+		const std::size_t first = nodeOffsets[nodeIdx], last = nodeOffsets[nodeIdx+1];
+		if(last - first < 2) {continue;}
+
+		perm.resize(last - first);
+		std::iota(perm.begin(),perm.end(),first);
+		std::sort(perm.begin(),perm.end(),[&](std::size_t a, std::size_t b) {
+			return midY[a] < midY[b] || (midY[a] == midY[b] && slope[a] < slope[b]);
+		});
+		std::vector<double> y(perm.size()), m(perm.size());
+		std::vector<ul> f(perm.size());
+		for(std::size_t i = 0; i < perm.size(); ++i) {
+			y[i] = midY[perm[i]];
+			m[i] = slope[perm[i]];
+			f[i] = faceAbove[perm[i]];
+		}
+		std::copy(y.begin(),y.end(),midY.begin() + first);
+		std::copy(m.begin(),m.end(),slope.begin() + first);
+		std::copy(f.begin(),f.end(),faceAbove.begin() + first);
+	}
+}
+
+/* the tree node of the leaf that contains x, 0 outside */
+std::size_t PointLocation::leaf(const double x) const {
+	if(xs.size() < 2 || x < xs.front() || x > xs.back()) {return 0;}
+	std::size_t i = std::upper_bound(xs.begin(),xs.end(),x) - xs.begin();
+	i = std::min(i,xs.size() - 1);
+	return numLeaves + i - 1;
+}
+
+ul PointLocation::face(const double x, const double y) const {
+	ul result = MAX;
+	double bestY = 0.0;
+	for(std::size_t nodeIdx = leaf(x); nodeIdx > 0; nodeIdx /= 2) {
+		const std::size_t i = below(nodeIdx,x,y);
+		if(i == MAX) {continue;}
+		const double segmentY = midY[i] + slope[i] * (x - nodeMidX[nodeIdx]);
+		if(result == MAX || segmentY > bestY) {
+			bestY  = segmentY;
+			result = i;
+		}
+	}
+	return (result != MAX) ? faceAbove[result] : MAX;
+}
+
+void PointLocation::locate(const double* x, const double* y, const std::size_t n, ul* faces, double* heights) const {
+	for(std::size_t q = 0; q < n; ++q) {
+		faces[q]   = face(x[q],y[q]);
+		heights[q] = (faces[q] != MAX) ? height(faces[q],x[q],y[q]) : 0.0;
+	}
+}
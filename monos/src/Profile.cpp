@@ -0,0 +1,145 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Profile.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+Profile::Profile(const Data& _data, const Wavefront& _wf):data(_data), wf(_wf) {
+	if(wf.nodes.empty()) {return;}
+
+	std::vector<NT> distance;
+	distance.reserve(wf.nodes.size());
+	for(const auto& node : wf.nodes) {
+		distance.push_back(squareRoot(node.time));
+	}
+
+	/* unit direction of every edge, the curve in its face runs along it */
+	std::vector<NT> ux, uy;
+	ux.reserve(data.getPolygon().size());
+	uy.reserve(data.getPolygon().size());
+	NT area0(0);
+	for(const auto& e : data.getPolygon()) {
+		const Point& U = data.p(e.u);
+		const Point& V = data.p(e.v);
+		const NT length = squareRoot((V - U).squared_length());
+		ux.push_back((V.x() - U.x()) / length);
+		uy.push_back((V.y() - U.y()) / length);
+		area0 += U.x() * V.y() - V.x() * U.y();
+	}
+	area0 /= NT(2);
+
+	/* the perimeter is the sum of alpha + beta*t over the arcs that cross t,
+	 * added at the lower and removed at the upper node of an arc. Walking
+	 * the boundary of a face counterclockwise, a crossing counts positive
+	 * where the offset increases; that is from the first to the second node
+	 * for the left face of an arc, the other way round for its right face */
+	std::vector<NT> alpha(wf.nodes.size(),NT(0)), beta(wf.nodes.size(),NT(0));
+	for(const auto& arc : wf.arcList) {
+		if(!arc.isEdge()) {continue;}
+		ul lowerIdx = arc.firstNodeIdx, upperIdx = arc.secondNodeIdx;
+		const NT& tFirst  = wf.nodes[lowerIdx].time;
+		const NT& tSecond = wf.nodes[upperIdx].time;
+		/* parallel to the curve, e.g., a front, it does not change the length */
+		if(tFirst == tSecond) {continue;}
+		const bool increasing = tFirst < tSecond;
+		if(!increasing) {std::swap(lowerIdx,upperIdx);}
+
+		NT dx(0), dy(0);
+		if(arc.leftEdgeIdx  != MAX) {dx += ux[arc.leftEdgeIdx];  dy += uy[arc.leftEdgeIdx];}
+		if(arc.rightEdgeIdx != MAX) {dx -= ux[arc.rightEdgeIdx]; dy -= uy[arc.rightEdgeIdx];}
+		if(!increasing) {dx = -dx; dy = -dy;}
+
+		/* the crossing at offset t is A + (t - dA) * w */
+		const Point& A = wf.nodes[lowerIdx].point;
+		const Point& B = wf.nodes[upperIdx].point;
+		const NT dA  = distance[lowerIdx];
+		const NT span = distance[upperIdx] - dA;
+		const NT wx = (B.x() - A.x()) / span;
+		const NT wy = (B.y() - A.y()) / span;
+
+		const NT a = dx * (A.x() - dA * wx) + dy * (A.y() - dA * wy);
+		const NT b = dx * wx + dy * wy;
+		alpha[lowerIdx] += a;  beta[lowerIdx] += b;
+		alpha[upperIdx] -= a;  beta[upperIdx] -= b;
+	}
+
+	std::vector<ul> order(wf.nodes.size());
+	for(ul i = 0; i < order.size(); ++i) {order[i] = i;}
+	std::sort(order.begin(),order.end(),[&](const ul& a, const ul& b) {
+		return wf.nodes[a].time < wf.nodes[b].time;
+	});
+
+	NT a(0), b(0), areaFrom = area0;
+	const Node* previous = &wf.nodes[order.front()];
+	NT from = distance[order.front()];
+	for(const auto& nodeIdx : order) {
+		if(wf.nodes[nodeIdx].time != previous->time) {
+			const NT& to = distance[nodeIdx];
+			const NT x = to - from;
+
+			Piece piece = {from,to,{areaFrom,NT(0),NT(0)},{a + b * from,b}};
+			piece.area[1] = -piece.perimeter[0];
+			piece.area[2] = -piece.perimeter[1] / NT(2);
+			totalVolume += x * (piece.area[0] + x * (piece.area[1] / NT(2) + x * piece.area[2] / NT(3)));
+			areaFrom     = piece.area[0] + x * (piece.area[1] + x * piece.area[2]);
+			pieces.push_back(piece);
+
+			previous = &wf.nodes[nodeIdx];
+			from = to;
+		}
+		a += alpha[nodeIdx];
+		b += beta[nodeIdx];
+	}
+}
+
+const Profile::Piece* Profile::pieceAt(const NT& t, NT& x) const {
+	if(pieces.empty()) {return nullptr;}
+	auto it = std::lower_bound(pieces.begin(),pieces.end(),t,[](const Piece& p, const NT& t) {return p.to < t;});
+	if(it == pieces.end()) {--it;}
+	x = std::max(NT(0),std::min(t,it->to) - it->from);
+	return &*it;
+}
+
+NT Profile::area(const NT& t) const {
+	NT x(0);
+	const Piece* p = pieceAt(t,x);
+	return (p != nullptr) ? p->area[0] + x * (p->area[1] + x * p->area[2]) : NT(0);
+}
+
+NT Profile::perimeter(const NT& t) const {
+	NT x(0);
+	const Piece* p = pieceAt(t,x);
+	return (p != nullptr) ? p->perimeter[0] + x * p->perimeter[1] : NT(0);
+}
+
+void Profile::write(const Config& cfg) const {
+	std::ofstream outfile (cfg.profileFileName,std::ofstream::binary);
+	outfile.precision(std::numeric_limits<double>::max_digits10);
+	outfile << "# profile autogenerated by monos from file (" << cfg.fileName << ")\n"
+			<< "# from to a0 a1 a2 p0 p1, area and perimeter in x = t - from\n"
+			<< "volume " << toDouble(totalVolume) << "\n";
+	for(const auto& p : pieces) {
+		outfile << toDouble(p.from) << " " << toDouble(p.to) << " "
+				<< toDouble(p.area[0]) << " " << toDouble(p.area[1]) << " " << toDouble(p.area[2]) << " "
+				<< toDouble(p.perimeter[0]) << " " << toDouble(p.perimeter[1]) << "\n";
+	}
+}
@@ -18,6 +18,14 @@
  */
 
 #include "Skeleton.h"
+#include "ObjWriter.h"
+#include "SkeletonFile.h"
+#include "Trace.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
 
 
 void Skeleton::initMerge() {
@@ -36,6 +44,19 @@ void Skeleton::finishMerge() {
 	ul lastTNodeIdx = data.e(lowerChain.back()).v;
 	Segment e(wf.getNode(lastTNodeIdx)->point, wf.getNode(sourceNodeIdx)->point);
 	wf.addArc(lastTNodeIdx,sourceNodeIdx,lowerChainIndex,upperChainIndex);
+
+	if(wf.isBounded()) {closeFronts();}
+
+	/* the skeleton is final, drop what the merge cut off and build the
+	 * compact node-arc adjacency and the half-edges; node references held
+	 * here are void now */
+	{
+		Timings::Scope phase(data.timings,Phase::COMPACTION);
+		wf.compact();
+		sourceNode = nullptr;
+		wf.adjacency.build(wf.nodes,wf.arcList);
+		wf.halfedges.build(data,wf.nodes,wf.arcList);
+	}
 	computationFinished = true;
 	LOG(INFO) << "Merge Finished!";
 }
@@ -54,7 +75,7 @@ void Skeleton::MergeUpperLowerSkeleton() {
  * Executes a single merge step along the merge line, return false if merge is finished
  * */
 bool Skeleton::SingleMergeStep() {
-	LOG(INFO) << "################################### START SINGLE MERGE STEP " << upperChainIndex << "/" << lowerChainIndex << " ######################";
+	TRACE(MERGE, MERGE_STEP, upperChainIndex, lowerChainIndex);
 
 	auto bisLine = data.simpleBisector(upperChainIndex,lowerChainIndex);
 	bool possibleGhostArcToRepair = false;
@@ -70,24 +91,24 @@ bool Skeleton::SingleMergeStep() {
 	/* correct direction if necessary */
 	if(ORIGIN > ORIGIN + bisLine.to_vector()) {bisLine = bisLine.opposite();}
 
-	LOG(INFO) << "Bisector-dir: " << bisLine.direction();
-
 	/* setup intersection call */
 	/* obtain the arcIdx and newPoint for the next bis arc intersection */
 	IntersectionPair intersectionPair = findNextIntersectingArc(bisLine);
 
+	/* a bounded merge does not pass the limit, it goes on behind the gap */
+	if(wf.isBounded() && !possibleGhostArcToRepair && beyondLimit(intersectionPair)) {
+		if(!crossGap(bisLine)) {return false;}
+		return !EndOfBothChains();
+	}
+
 	newNodeIdx = handleMerge(intersectionPair,possibleGhostArcToRepair);
 
 
 	/* we iterate the sourcenode to the newly added node and go on merging */
-	LOG(INFO) << "changing idx from old: " << sourceNodeIdx << " to " << newNodeIdx;
+	TRACE(MERGE, MERGE_NODE, newNodeIdx, sourceNodeIdx);
 	sourceNodeIdx = newNodeIdx;
 	sourceNode = &wf.nodes[sourceNodeIdx];
 
-	LOG(INFO) << "";
-	LOG(INFO) << "############################################## END STEP ###########################";
-	LOG(INFO) << "  ( next is ui: " << upperChainIndex << ", a: " << upperPath << " -- li: " << lowerChainIndex <<", a: " << lowerPath << " )   ";
-
 	return !EndOfBothChains();
 }
 
@@ -116,11 +137,12 @@ IntersectionPair Skeleton::findNextIntersectingArc(const Line& bis) {
 
 	bool upperBothDir = false;
 	bool lowerBothDir = false;
+	unsigned long visited = 0;
 
 	do {
 		if(!doneU && !doneL) {
-			uPa = upperArc->source(); uPb = upperArc->target();
-			lPa = lowerArc->source(); lPb = lowerArc->target();
+			uPa = wf.getArcSource(*upperArc); uPb = wf.getArcTarget(*upperArc);
+			lPa = wf.getArcSource(*lowerArc); lPb = wf.getArcTarget(*lowerArc);
 			if(uPb < uPa) {std::swap(uPa, uPb);}
 			if(lPb < lPa) {std::swap(lPa, lPb);}
 
@@ -131,9 +153,10 @@ IntersectionPair Skeleton::findNextIntersectingArc(const Line& bis) {
 		if(doneL) {searchChain = ChainType::UPPER;}
 
 		if(!doneU && searchChain == ChainType::UPPER && !EndOfUpperChain()) {
-			LOG(INFO) << "upper checking " << *upperArc << " forw: " << iterateForwardU;
+			TRACE(MERGE, MERGE_CHECK_ARC, upperPath, 0);
+			++visited;
 			if(isIntersecting(bis,*upperArc)) {
-				Pu = intersectElements(bis,upperArc->supporting_line());
+				Pu = intersectElements(bis,wf.getArcLine(*upperArc));
 				doneU = true;
 			} else {
 				upperPath = wf.getNextArcIdx(upperPath,iterateForwardU,upperChainIndex);
@@ -152,10 +175,11 @@ IntersectionPair Skeleton::findNextIntersectingArc(const Line& bis) {
 		}
 
 		if(!doneL && searchChain == ChainType::LOWER && !EndOfLowerChain()) {
-			LOG(INFO) << "lower checking " << *lowerArc << " forw: " << iterateForwardL;
+			TRACE(MERGE, MERGE_CHECK_ARC, lowerPath, 1);
+			++visited;
 
 			if(isIntersecting(bis,*lowerArc)) {
-				Pl = intersectElements(bis,lowerArc->supporting_line());
+				Pl = intersectElements(bis,wf.getArcLine(*lowerArc));
 				doneL = true;
 			} else {
 				lowerPath = wf.getNextArcIdx(lowerPath,iterateForwardL,lowerChainIndex);
@@ -174,6 +198,7 @@ IntersectionPair Skeleton::findNextIntersectingArc(const Line& bis) {
 		}
 	} while(!doneU || !doneL);
 
+	data.statistics.mergeStep(visited);
 	return std::make_pair(Pu,Pl);
 }
 
@@ -196,6 +221,7 @@ ul Skeleton::handleMerge(const IntersectionPair& intersectionPair, bool possible
 	if(possibleGhostArcToRepair) {
 		LOG(INFO) << "---(ghost hunt) checking possible ghost arc to the left";
 		if(checkForPossibleReverseGhostArc(Pu,Pl)) {
+			++data.statistics.ghostArcRepairs;
 			if(Pu != sourceNode->point) {
 				/* now we know and have to repair the 'sourceNode'
 				 * as it should be horizontal to the left of Pl, Pu */
@@ -263,7 +289,7 @@ ul Skeleton::handleMerge(const IntersectionPair& intersectionPair, bool possible
 		newNodeIdx = wf.addNode(P,dist);
 		/* update the targets of the relevant arcs */
 		LOG(INFO) << "before update of " << path;
-		updateArcTarget(path,edgeIdx,newNodeIdx,P);
+		updateArcTarget(path,edgeIdx,newNodeIdx);
 	}
 
 	const ul newArcIdx 	= wf.addArc(sourceNodeIdx,newNodeIdx,upperChainIndex,lowerChainIndex);
@@ -272,12 +298,10 @@ ul Skeleton::handleMerge(const IntersectionPair& intersectionPair, bool possible
 		wf.pathFinder[upperChainIndex].a = newNodeIdx;
 		upperChainIndex = intersArc->leftEdgeIdx;
 		wf.pathFinder[upperChainIndex].b = newNodeIdx;
-		LOG(INFO) << "handleMerge: set upper chain to " << upperChainIndex << " arc: " << upperPath;
 	} else {
 		wf.pathFinder[lowerChainIndex].b = newNodeIdx;
 		lowerChainIndex = intersArc->rightEdgeIdx;
 		wf.pathFinder[lowerChainIndex].a = newNodeIdx;
-		LOG(INFO) << "handleMerge: set lower chain to " << lowerChainIndex << " arc: " << lowerPath;
 	}
 
 	if(winner == ChainType::BOTH) {
@@ -288,7 +312,7 @@ ul Skeleton::handleMerge(const IntersectionPair& intersectionPair, bool possible
 		auto intersArcL = wf.getArc(path);
 
 		auto newNode = wf.getNode(newNodeIdx);
-		std::vector<ul>* checkArcs = nullptr;
+		NodeArcs* checkArcs = nullptr;
 		ul checkIdx = MAX;
 
 		if(dist == wf.getNode(intersArcL->firstNodeIdx)->time
@@ -305,7 +329,7 @@ ul Skeleton::handleMerge(const IntersectionPair& intersectionPair, bool possible
 			checkIdx = intersArcL->secondNodeIdx;
 			intersArcL = wf.getRightmostArcEndingAtNode(*wf.getNode(intersArcL->secondNodeIdx),intersArcL);
 		} else {
-			updateArcTarget(path,edgeIdx,newNodeIdx,P);
+			updateArcTarget(path,edgeIdx,newNodeIdx);
 		}
 
 		if(checkIdx != MAX) {
@@ -365,7 +389,7 @@ ul Skeleton::handleMerge(const IntersectionPair& intersectionPair, bool possible
 }
 
 
-void Skeleton::updateArcTarget(const ul& arcIdx, const ul& edgeIdx, const int& secondNodeIdx, const Point& edgeEndPoint) {
+void Skeleton::updateArcTarget(const ul& arcIdx, const ul& edgeIdx, const ul& secondNodeIdx) {
 	auto arc = &wf.arcList[arcIdx];
 
 	if(arc->isDisable()) {return;}
@@ -376,23 +400,22 @@ void Skeleton::updateArcTarget(const ul& arcIdx, const ul& edgeIdx, const int& s
 		removePath(arcIdx, edgeIdx);
 	}
 
-	LOG(INFO) << "in update " << *arc;
-
 	auto newNode = &wf.nodes[secondNodeIdx];
 
-	if(arc->point(0) == newNode->point) {
+	if(wf.getArcSource(*arc) == newNode->point) {
 		arc->disable();
 		return;
-	} else {
-		wf.arcList[arcIdx] = Arc(ArcType::NORMAL, arc->firstNodeIdx, secondNodeIdx,
-								arc->leftEdgeIdx, arc->rightEdgeIdx, arc->id,
-								Segment(arc->source(),edgeEndPoint)
-							 );
 	}
 
-	newNode->arcs.push_back(arcIdx);
+	/* only the target moves, a ray becomes a bounded arc */
+	if(arc->isRay()) {
+		wf.rayTargets[arcIdx] = INFPOINT;
+		arc->type = ArcType::NORMAL;
+	}
+	arc->secondNodeIdx = secondNodeIdx;
 
-	LOG(INFO) << "after update" << *arc;
+	newNode->arcs.push_back(arcIdx);
+	TRACE(MERGE, MERGE_ARC_TARGET, arcIdx, secondNodeIdx);
 }
 
 bool Skeleton::decideDirection(ChainType type, const Line& bis) const {
@@ -406,9 +429,9 @@ bool Skeleton::decideDirection(ChainType type, const Line& bis) const {
 	}
 
 	if(type == ChainType::UPPER) {
-		return bis.has_on_positive_side(arc->source());
+		return bis.has_on_positive_side(wf.getArcSource(*arc));
 	} else {
-		return bis.has_on_negative_side(arc->source());
+		return bis.has_on_negative_side(wf.getArcSource(*arc));
 	}
 }
 
@@ -451,6 +474,183 @@ void Skeleton::removePath(const ul& arcIdx, const ul& edgeIdx)  {
 	}
 }
 
+/*******************************************************************************************/
+/*                                  BOUNDED MERGE                                          */
+/*******************************************************************************************/
+/* true if the next merge node lies above the limit, chain skeletons of a
+ * bounded run end in rays at the limit, hence there may be no intersection */
+bool Skeleton::beyondLimit(const IntersectionPair& intersectionPair) const {
+	const Point& Pu = intersectionPair.first;
+	const Point& Pl = intersectionPair.second;
+	if(Pu == INFPOINT && Pl == INFPOINT) {return true;}
+
+	if(chooseWinnerUpperLower(Pu,Pl) == ChainType::LOWER) {
+		return data.normalDistance(lowerChainIndex,Pl) > wf.maxTime;
+	}
+	return data.normalDistance(upperChainIndex,Pu) > wf.maxTime;
+}
+
+/* end the merge line on the fronts and resume it where they meet again */
+bool Skeleton::crossGap(const Line& bis) {
+	const Line upperFront = data.offsetLine(upperChainIndex,wf.maxOffset);
+	const Line lowerFront = data.offsetLine(lowerChainIndex,wf.maxOffset);
+	Point P = (!CGAL::parallel(upperFront,lowerFront)) ? intersectElements(upperFront,lowerFront)
+													   : intersectElements(bis,upperFront);
+
+	FrontGap gap;
+	gap.leaveNodeIdx = wf.addNode(P,wf.maxTime);
+	wf.addArc(sourceNodeIdx,gap.leaveNodeIdx,upperChainIndex,lowerChainIndex);
+	wf.pathFinder[upperChainIndex].a = gap.leaveNodeIdx;
+	wf.pathFinder[lowerChainIndex].b = gap.leaveNodeIdx;
+
+	ul upperIdx = upperChainIndex, lowerIdx = lowerChainIndex;
+	if(!findGapEnd(gap,upperIdx,lowerIdx,P)) {
+		LOG(ERROR) << "the fronts do not meet again right of " << wf.nodes[gap.leaveNodeIdx];
+		return false;
+	}
+	gap.enterNodeIdx = wf.addNode(P,wf.maxTime);
+	LOG(INFO) << "-- gap between the fronts from " << gap.leaveNodeIdx << " to " << gap.enterNodeIdx;
+
+	sourceNodeIdx   = gap.enterNodeIdx;
+	sourceNode      = &wf.nodes[sourceNodeIdx];
+	upperChainIndex = upperIdx;
+	lowerChainIndex = lowerIdx;
+	wf.pathFinder[upperChainIndex].b = gap.enterNodeIdx;
+	wf.pathFinder[lowerChainIndex].a = gap.enterNodeIdx;
+	gaps.emplace_back(std::move(gap));
+
+	initPathForEdge(ChainType::UPPER);
+	initPathForEdge(ChainType::LOWER);
+	return true;
+}
+
+/* walks the lower and the upper front to the right, starting with the given
+ * edges at the point the merge line left through; both fronts are x-monotone,
+ * thus we always advance the one whose current segment ends first */
+bool Skeleton::findGapEnd(FrontGap& gap, ul& upperIdx, ul& lowerIdx, Point& P) {
+	const Chain& upper = wf.getChain(ChainType::UPPER);
+	const Chain& lower = wf.getChain(ChainType::LOWER);
+
+	auto lowerRight = [&]() {return (lowerIdx != lower.back())  ? frontVertex(lowerIdx,lower.next(lowerIdx)) : INFPOINT;};
+	auto upperRight = [&]() {return (upperIdx != upper.front()) ? frontVertex(upper.prev(upperIdx),upperIdx) : INFPOINT;};
+	/* X lies on the front line of the edge, compare along that line */
+	auto onSegment  = [&](const Point& X, const Point& a, const Point& b, const ul& edgeIdx) {
+		const bool vertical = data.get_line(edgeIdx).is_vertical();
+		const NT&  x = (vertical) ? X.y() : X.x();
+		const NT&  s = (vertical) ? a.y() : a.x();
+		const NT&  t = (vertical) ? b.y() : b.x();
+		return (s < t) ? (s <= x && x <= t) : (t <= x && x <= s);
+	};
+
+	Point lLeft = P, uLeft = P;
+	Point lRight = lowerRight(), uRight = upperRight();
+	gap.lower.push_back(lowerIdx);
+	gap.upper.push_back(upperIdx);
+
+	/* the fronts of the first two edges meet at P only */
+	bool first = true;
+	while(true) {
+		const Line lowerFront = data.offsetLine(lowerIdx,wf.maxOffset);
+		const Line upperFront = data.offsetLine(upperIdx,wf.maxOffset);
+		if(!first && !CGAL::parallel(lowerFront,upperFront)) {
+			P = intersectElements(upperFront,lowerFront);
+			if(onSegment(P,lLeft,lRight,lowerIdx) && onSegment(P,uLeft,uRight,upperIdx)) {return true;}
+		} else if(!first && data.get_line(lowerIdx) == data.get_line(upperIdx)) {
+			/* collinear edges, their fronts overlap and the merge line is
+			 * normal to them, half way between the two edges */
+			const Point M = CGAL::midpoint(data.eB(lowerIdx),data.eA(upperIdx));
+			P = intersectElements(lowerFront,data.get_line(lowerIdx).perpendicular(M));
+			if(onSegment(P,lLeft,lRight,lowerIdx) && onSegment(P,uLeft,uRight,upperIdx)) {return true;}
+		}
+		first = false;
+
+		if(lRight == INFPOINT && uRight == INFPOINT) {return false;}
+
+		/* on a tie the front that goes on vertically at that x comes first,
+		 * otherwise we would skip its pair with the other front */
+		bool advanceLower = lRight.x() < uRight.x();
+		bool advanceUpper = uRight.x() < lRight.x();
+		if(lRight.x() == uRight.x()) {
+			advanceLower = data.get_line(lower.next(lowerIdx)).is_vertical();
+			advanceUpper = data.get_line(upper.prev(upperIdx)).is_vertical();
+			if(advanceLower == advanceUpper) {advanceLower = advanceUpper = true;}
+		}
+		if(advanceLower) {
+			gap.lowerPoints.push_back(lRight);
+			lowerIdx = lower.next(lowerIdx);
+			gap.lower.push_back(lowerIdx);
+			lLeft  = lRight;
+			lRight = lowerRight();
+		}
+		if(advanceUpper) {
+			gap.upperPoints.push_back(uRight);
+			upperIdx = upper.prev(upperIdx);
+			gap.upper.push_back(upperIdx);
+			uLeft  = uRight;
+			uRight = upperRight();
+		}
+	}
+}
+
+/* the point at the limit on the ray between two consecutive edges of a chain */
+Point Skeleton::frontVertex(const ul& aIdx, const ul& bIdx) const {
+	const Line a = data.offsetLine(aIdx,wf.maxOffset);
+	const Line b = data.offsetLine(bIdx,wf.maxOffset);
+	if(!CGAL::parallel(a,b)) {
+		return intersectElements(a,b);
+	}
+	/* collinear edges, the ray is normal to both */
+	const Point& source = wf.getArcSource(*wf.getArc(wf.frontRays[aIdx]));
+	return intersectElements(a,data.get_line(aIdx).perpendicular(source));
+}
+
+/* the ray ends at the limit now, returns the new node */
+ul Skeleton::clipRay(const ul& arcIdx, const Point& P) {
+	const ul nodeIdx = wf.addNode(P,wf.maxTime);
+	auto arc = wf.getArc(arcIdx);
+	if(!arc->isRay()) {
+		LOG(WARNING) << "front vertex on a merged arc " << *arc;
+		return nodeIdx;
+	}
+	wf.rayTargets[arcIdx] = INFPOINT;
+	arc->type = ArcType::NORMAL;
+	arc->secondNodeIdx = nodeIdx;
+	wf.nodes[nodeIdx].arcs.push_back(arcIdx);
+	return nodeIdx;
+}
+
+/* clip the rays in the gaps and add the fronts as arcs: a front arc has
+ * its face on the left and no face (MAX) on the right, the lower front
+ * runs from right to left and the upper front from left to right */
+void Skeleton::closeFronts() {
+	std::vector<ul> frontNodes;
+	for(const auto& gap : gaps) {
+		frontNodes.assign(1,gap.leaveNodeIdx);
+		for(ul i = 0; i < gap.lowerPoints.size(); ++i) {
+			frontNodes.push_back(clipRay(wf.frontRays[gap.lower[i]],gap.lowerPoints[i]));
+		}
+		frontNodes.push_back(gap.enterNodeIdx);
+		for(ul i = 0; i < gap.lower.size(); ++i) {
+			wf.addArc(frontNodes[i+1],frontNodes[i],gap.lower[i],MAX);
+		}
+
+		frontNodes.assign(1,gap.leaveNodeIdx);
+		for(ul i = 0; i < gap.upperPoints.size(); ++i) {
+			frontNodes.push_back(clipRay(wf.frontRays[gap.upper[i+1]],gap.upperPoints[i]));
+		}
+		frontNodes.push_back(gap.enterNodeIdx);
+		for(ul i = 0; i < gap.upper.size(); ++i) {
+			wf.addArc(frontNodes[i],frontNodes[i+1],gap.upper[i],MAX);
+		}
+	}
+
+	for(const auto& arc : wf.arcList) {
+		if(arc.isRay()) {
+			LOG(WARNING) << "ray left after a bounded merge " << arc;
+		}
+	}
+}
+
 /*******************************************************************************************/
 /*                                  'GHOST' ARC STUFF                                      */
 /*******************************************************************************************/
@@ -458,8 +658,10 @@ bool Skeleton::checkForPossibleReverseGhostArc(Point& Pu, Point& Pl) {
 	/* very basic check */
 	auto arc_u = wf.getArc(upperPath);
 	auto arc_l = wf.getArc(lowerPath);
-	if(CGAL::do_intersect(*arc_u,*arc_l)) {
-		Point P = intersectElements(*arc_u,*arc_l);
+	auto seg_u = wf.getArcSegment(*arc_u);
+	auto seg_l = wf.getArcSegment(*arc_l);
+	if(CGAL::do_intersect(seg_u,seg_l)) {
+		Point P = intersectElements(seg_u,seg_l);
 		Pu = P;
 		Pl = P;
 		LOG(INFO) << "---(ghost hunt) intersection between arcs found!";
@@ -473,9 +675,9 @@ void Skeleton::findAndRepairGhostArroundSource(const Point& P) {
 	/* subdivide arc and place a new sourceNode */
 	if(arc != nullptr) {
 		/* seems we have found a place to put a new 'sourceNode' */
-		if(P != arc->point(0) && P != arc->point(1)) {
+		if(P != wf.getArcSource(*arc) && P != wf.getArcTarget(*arc)) {
 			/* not node incident at P, so lets split arc up */
-			NT x = arc->supporting_line().x_at_y(P.y());
+			NT x = wf.getArcLine(*arc).x_at_y(P.y());
 			Point PInt(x,P.y());
 			ul newNodeIdx = wf.addNode(PInt,normalDistance(data.get_line(upperChainIndex),PInt));
 			ul newArcIdx = MAX;
@@ -500,6 +702,9 @@ void Skeleton::findAndRepairGhostArroundSource(const Point& P) {
 /*                                  WRITE OUTPUT                                           */
 /*******************************************************************************************/
 void Skeleton::writeOBJ(const Config& cfg) const {
+	/* no --out, nothing to convert */
+	if(cfg.outputFileName.empty()) {return;}
+
 	double xt = 0.0, yt = 0.0, zt = 0.0, xm = 1.0, ym = 1.0, zm = 1.0;
 	if(cfg.normalize) {
 		getNormalizer(*data.bbox,xt,xm,yt,ym,zt,zm);
@@ -509,76 +714,150 @@ void Skeleton::writeOBJ(const Config& cfg) const {
 		ym = 1.0/OBJSCALE;
 	}
 
-	LOG(INFO) << "writing OBJ: " << wf.nodes.size(); fflush(stdout);
+	TRACE(OUTPUT, WRITE_OBJ, wf.nodes.size(), wf.arcList.size());
 
 	zm /= OBJSCALE;
-	ul errorCnt = 20;
-
-	std::ofstream outfile (cfg.outputFileName,std::ofstream::binary);
-	outfile << "# OBJ-File autogenerated by monos from file ("
-			<< cfg.fileName << ") - "
-			<< currentTimeStamp() <<  std::endl;
 
-	/* write points/nodes into file */
-	for(auto n : wf.nodes) {
-#ifdef WITH_FP
-		double x = (n.point.x() - xt)   * xm;
-		double y = (n.point.y() - yt)   * ym;
-		double z = CGAL::to_double(CGAL::sqrt(n.time))   * zm;
-#else
-		double x = (n.point.x().doubleValue() - xt)   * xm;
-		double y = (n.point.y().doubleValue() - yt)   * ym;
-		double z = CGAL::sqrt(n.time).doubleValue()   * zm;
-#endif
-		outfile << "v " << x << " " << y << " " << z << std::endl;
+	ObjWriter out(cfg.outputFileName);
+	out.comment("OBJ-File autogenerated by monos from file (" + cfg.fileName + ") - " + currentTimeStamp());
+
+	/* all nodes to doubles in one pass, transformed for the output; the
+	 * exact numbers share subexpressions and are not converted in parallel */
+	const ul numNodes = wf.nodes.size();
+	std::vector<double> xs(numNodes), ys(numNodes), zs(numNodes);
+	for(ul i = 0; i < numNodes; ++i) {
+		const auto& n = wf.nodes[i];
+		xs[i] = (toDouble(n.point.x()) - xt) * xm;
+		ys[i] = (toDouble(n.point.y()) - yt) * ym;
+		zs[i] = toDouble(squareRoot(n.time))  * zm;
 	}
+	out.vertices(xs.data(),ys.data(),zs.data(),numNodes);
 
-	/* write faces induced by the skeleton into file */
+	/* write faces induced by the skeleton into file, each is the cycle of
+	 * half-edges starting at its polygon edge */
+	const auto& he = wf.halfedges;
 	for(ul edgeIdx = 0; edgeIdx < data.getPolygon().size(); ++edgeIdx) {
-		auto e = data.e(edgeIdx);
-		std::vector<Node*> tN = {{&wf.nodes[e.u],&wf.nodes[e.v]}};
+		const ul first = he.faceHalfedge(edgeIdx);
+		ul h = first, steps = 0;
 
-		/* we walk from the right (index 1) terminal node along the boudnary of the
-		 * induced face to the first (index 0) terminal node */
-		auto arcIdx = tN[1]->arcs.front();
-		auto srcNodeIdx = e.u;
-		auto arcIt = wf.getArc(arcIdx);
+		out.begin('f');
+		do {
+			out.index(he.origin(h));
+			h = he.next(h);
+		} while(h != first && h != MAX && ++steps < he.size());
 
-		outfile << "f " << e.u+1;
+		if(h != first) {LOG(WARNING) << "face of edge " << edgeIdx << " is not closed";}
+		out.end();
+	}
 
-		do {
-			auto nextNodeIdx = arcIt->getSecondNodeIdx(srcNodeIdx);
-
-			if(nextNodeIdx == INFINITY) {LOG(WARNING) << "infinite node in list!"; break;}
-
-			/* +1 is the standard OBJ offset for references */
-			outfile << " " << nextNodeIdx+1;
-
-			auto n = &wf.nodes[nextNodeIdx];
-			bool found = false;
-			for(auto newArcIdx : n->arcs) {
-				if(arcIdx != newArcIdx) {
-					arcIt = wf.getArc(newArcIdx);
-					if(arcIt->isDisable()) {continue;}
-					if(arcIt->leftEdgeIdx == edgeIdx || arcIt->rightEdgeIdx == edgeIdx) {
-						found  = true;
-						arcIdx = newArcIdx;
-						break;
-					}
+	/* the fronts of a bounded run, each a closed line along its front arcs */
+	if(wf.isBounded()) {
+		std::vector<bool> visited(wf.arcList.size(),false);
+		for(const auto& arc : wf.arcList) {
+			if(arc.rightEdgeIdx != MAX || visited[arc.id]) {continue;}
+			out.begin('l');
+			out.index(arc.firstNodeIdx);
+			const Arc* it = &arc;
+			while(!visited[it->id]) {
+				visited[it->id] = true;
+				out.index(it->secondNodeIdx);
+				for(auto a = wf.adjacency.begin(it->secondNodeIdx); a != wf.adjacency.end(it->secondNodeIdx); ++a) {
+					const Arc& next = wf.arcList[*a];
+					if(next.rightEdgeIdx == MAX && next.firstNodeIdx == it->secondNodeIdx) {it = &next; break;}
 				}
 			}
+			out.end();
+		}
+	}
 
-			if(!n->isTerminal() && !found) {
-				LOG(WARNING) << "did not find a next arc! current node: " << nextNodeIdx << " " << *n;
-				--errorCnt;
-			}
+	/* the input polygon as one face on the ground */
+	out.begin('f');
+	for(const auto& e : data.getPolygon()) {
+		out.index(e.u);
+	}
+	out.end();
+
+	out.flush();
+	if(!out.good()) {LOG(ERROR) << "could not write " << cfg.outputFileName;}
+}
+
+/* CORE prints an expression at its default relative precision (60 bits)
+ * whatever the stream asks for, thus it is refined to the digits first */
+static std::string exactDigits(const NT& x) {
+#ifdef WITH_FP
+	std::ostringstream out;
+	out.precision(EXACT_DIGITS);
+	out << x;
+	return out.str();
+#else
+	/* log2(10) bits per digit and a few more against the rounding */
+	const long bits = static_cast<long>(std::ceil(EXACT_DIGITS * std::log2(10.0))) + 8;
+	const CORE::Real& r = x.approx(CORE::extLong(bits),CORE::extLong::getPosInfty());
+	return r.BigFloatValue().toString(EXACT_DIGITS,true);
+#endif
+}
 
-			srcNodeIdx = nextNodeIdx;
+bool Skeleton::writeBinary(const Config& cfg) const {
+	using namespace skeletonfile;
+	auto index = [](const ul& idx) -> uint64_t {return (idx != MAX) ? idx : NONE;};
 
-		} while(arcIt->secondNodeIdx != e.u && arcIt->firstNodeIdx != e.u && errorCnt > 0);
+	/* the coordinates as they are, without the OBJ scale or --normalize */
+	std::vector<NodeRecord> nodes(wf.nodes.size());
+	for(ul i = 0; i < nodes.size(); ++i) {
+		const auto& n = wf.nodes[i];
+		nodes[i] = {toDouble(n.point.x()), toDouble(n.point.y()), toDouble(squareRoot(n.time))};
+	}
 
-		outfile << std::endl;
+	std::vector<ArcRecord> arcs(wf.arcList.size());
+	for(const auto& arc : wf.arcList) {
+		arcs[arc.id] = {index(arc.firstNodeIdx), arc.isEdge() ? index(arc.secondNodeIdx) : NONE,
+						index(arc.leftEdgeIdx), index(arc.rightEdgeIdx)};
 	}
 
-	outfile.close();
+	/* the faces as in writeOBJ, the cycle of half-edges from its polygon edge */
+	const auto& he = wf.halfedges;
+	const ul numFaces = data.getPolygon().size();
+	std::vector<uint64_t> faceOffsets, faceNodes;
+	faceOffsets.reserve(numFaces + 1);
+	faceNodes.reserve(he.size() / 2);
+	faceOffsets.push_back(0);
+	for(ul edgeIdx = 0; edgeIdx < numFaces; ++edgeIdx) {
+		const ul first = he.faceHalfedge(edgeIdx);
+		ul h = first, steps = 0;
+		do {
+			faceNodes.push_back(he.origin(h));
+			h = he.next(h);
+		} while(h != first && h != MAX && ++steps < he.size());
+		faceOffsets.push_back(faceNodes.size());
+	}
+
+	std::vector<uint64_t> polygon;
+	polygon.reserve(numFaces);
+	for(const auto& e : data.getPolygon()) {polygon.push_back(e.u);}
+
+	const Header header = makeHeader(nodes.size(),arcs.size(),numFaces,faceNodes.size(),polygon.size());
+
+	std::FILE* file = std::fopen(cfg.binaryFileName.c_str(),"wb");
+	if(file == nullptr) {return false;}
+	auto write = [&](const void* ptr, std::size_t size, std::size_t count) {
+		return std::fwrite(ptr,size,count,file) == count;
+	};
+	bool ok = write(&header,sizeof(header),1)
+		   && write(nodes.data(),sizeof(NodeRecord),nodes.size())
+		   && write(arcs.data(),sizeof(ArcRecord),arcs.size())
+		   && write(faceOffsets.data(),sizeof(uint64_t),faceOffsets.size())
+		   && write(faceNodes.data(),sizeof(uint64_t),faceNodes.size())
+		   && write(polygon.data(),sizeof(uint64_t),polygon.size());
+	ok = (std::fclose(file) == 0) && ok;
+
+	/* the numbers of the kernel as text, EXACT_DIGITS significant digits */
+	if(ok && !cfg.exactFileName.empty()) {
+		std::ofstream exact(cfg.exactFileName,std::ofstream::binary);
+		for(const auto& n : wf.nodes) {
+			exact << exactDigits(n.point.x()) << " " << exactDigits(n.point.y()) << " "
+				  << exactDigits(squareRoot(n.time)) << "\n";
+		}
+		ok = static_cast<bool>(exact);
+	}
+	return ok;
 }
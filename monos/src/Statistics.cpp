@@ -0,0 +1,46 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Statistics.h"
+
+void Statistics::writeJSON(std::ostream& os) const {
+	os << "{\"single_events\": " << singleEvents
+	   << ", \"multi_events\": " << multiEvents
+	   << ", \"multi_event_edges\": " << multiEventEdges
+	   << ", \"stale_events\": " << staleEvents
+	   << ", \"reinserts\": " << reinserts
+	   << ", \"peak_queue_size\": " << peakQueueSize
+	   << ", \"merge_steps\": " << mergeSteps
+	   << ", \"arcs_visited\": " << arcsVisited
+	   << ", \"max_arcs_visited\": " << maxArcsVisited
+	   << ", \"ghost_arc_repairs\": " << ghostArcRepairs
+	   << ", \"disabled_arcs\": " << disabledArcs << "}";
+}
+
+std::ostream& operator<< (std::ostream& os, const Statistics& stats) {
+	os << "events: " << stats.singleEvents << " single, "
+	   << stats.multiEvents << " multi (" << stats.multiEventEdges << " edges), "
+	   << stats.staleEvents << " stale, " << stats.reinserts << " re-inserted, "
+	   << "peak queue " << stats.peakQueueSize
+	   << "; merge: " << stats.mergeSteps << " steps, "
+	   << stats.arcsVisited << " arcs visited (" << stats.arcsVisitedPerStep() << " per step, max "
+	   << stats.maxArcsVisited << "), " << stats.ghostArcRepairs << " ghost arc repairs, "
+	   << stats.disabledArcs << " disabled arcs";
+	return os;
+}
@@ -0,0 +1,186 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <ctime>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "Timings.h"
+#include "Statistics.h"
+
+static const char* phaseNames[] = {
+	"read", "decompose", "init queue", "lower chain",
+	"upper chain", "merge", "compaction", "write"
+};
+
+const char* Timings::name(Phase p) {
+	return phaseNames[static_cast<unsigned>(p)];
+}
+
+/* the current resident set in kB, read from /proc/self/statm */
+static long currentRSS() {
+	long pages = 0;
+	FILE* f = fopen("/proc/self/statm","r");
+	if(f == nullptr) {return 0;}
+	if(fscanf(f,"%*s %ld",&pages) != 1) {pages = 0;}
+	fclose(f);
+	return pages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static std::string jsonEscape(const std::string& s) {
+	std::string out;
+	for(char c : s) {
+		if(c == '"' || c == '\\') {out += '\\';}
+		out += c;
+	}
+	return out;
+}
+
+Timings::Sample Timings::now() const {
+	auto wall = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	struct timespec ts;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID,&ts);
+	return {wall, ts.tv_sec + ts.tv_nsec * 1e-9, currentRSS(), geometry::counts, allocation::counts,
+			(perf != nullptr) ? perf->read() : PerfCounters::Values{}};
+}
+
+void Timings::charge(Phase p, const Sample& s) {
+	auto& r     = reports[static_cast<unsigned>(p)];
+	r.wall     += s.wall - last.wall;
+	r.cpu      += s.cpu  - last.cpu;
+	r.rssDelta += s.rss  - last.rss;
+	for(unsigned i = 0; i < geometry::NUM_OPS; ++i) {
+		r.ops[i] += s.ops[i] - last.ops[i];
+	}
+	r.allocs.allocations += s.allocs.allocations - last.allocs.allocations;
+	r.allocs.bytes       += s.allocs.bytes       - last.allocs.bytes;
+	r.allocs.frees       += s.allocs.frees       - last.allocs.frees;
+	/* a failed read gives 0 and the scaled estimate of a multiplexed
+	 * counter may go down, such a counter keeps its last good reading */
+	auto hw = s.hw;
+	for(unsigned i = 0; i < PerfCounters::NUM; ++i) {
+		if(s.hw[i] < last.hw[i]) {
+			hw[i] = last.hw[i];
+		} else {
+			r.hw[i] += s.hw[i] - last.hw[i];
+		}
+	}
+	last = s;
+	last.hw = hw;
+}
+
+void Timings::enter(Phase p) {
+	auto s = now();
+	if(!running.empty()) {
+		charge(running.back(),s);
+	} else {
+		last = s;
+	}
+	running.push_back(p);
+	++reports[static_cast<unsigned>(p)].calls;
+}
+
+void Timings::leave() {
+	assert(!running.empty());
+	charge(running.back(),now());
+	running.pop_back();
+}
+
+Timings::Report Timings::sum(Phase first, Phase last) const {
+	Report total;
+	for(auto i = static_cast<unsigned>(first); i <= static_cast<unsigned>(last); ++i) {
+		total.wall     += reports[i].wall;
+		total.cpu      += reports[i].cpu;
+		total.rssDelta += reports[i].rssDelta;
+		total.calls    += reports[i].calls;
+		for(unsigned j = 0; j < geometry::NUM_OPS; ++j) {
+			total.ops[j] += reports[i].ops[j];
+		}
+		total.allocs.allocations += reports[i].allocs.allocations;
+		total.allocs.bytes       += reports[i].allocs.bytes;
+		total.allocs.frees       += reports[i].allocs.frees;
+		for(unsigned j = 0; j < PerfCounters::NUM; ++j) {
+			total.hw[j] += reports[i].hw[j];
+		}
+	}
+	return total;
+}
+
+void Timings::writeJSON(std::ostream& os, const std::string& fileName, unsigned long numVertices,
+		const Statistics* statistics) const {
+	struct rusage usage;
+	long maxRSS = (getrusage(RUSAGE_SELF,&usage) == 0) ? usage.ru_maxrss : 0;
+	auto total  = sum(Phase::READ,Phase::WRITE);
+
+	os << std::setprecision(9);
+	os << "{\n"
+	   << "  \"file\": \"" << jsonEscape(fileName) << "\",\n"
+	   << "  \"vertices\": " << numVertices << ",\n"
+	   << "  \"phases\": [\n";
+	for(unsigned i = 0; i < reports.size(); ++i) {
+		const auto& r = reports[i];
+		os << "    {\"name\": \"" << phaseNames[i] << "\""
+		   << ", \"wall\": " << r.wall
+		   << ", \"cpu\": " << r.cpu
+		   << ", \"rss_delta_kb\": " << r.rssDelta
+		   << ", \"calls\": " << r.calls;
+		if(geometry::enabled()) {
+			os << ", \"ops\": {";
+			for(unsigned j = 0; j < geometry::NUM_OPS; ++j) {
+				os << (j > 0 ? ", " : "") << "\"" << geometry::opNames[j] << "\": " << r.ops[j];
+			}
+			os << "}";
+		}
+		if(allocation::enabled()) {
+			os << ", \"allocations\": " << r.allocs.allocations
+			   << ", \"allocated_bytes\": " << r.allocs.bytes
+			   << ", \"frees\": " << r.allocs.frees;
+		}
+		if(perf != nullptr && perf->available()) {
+			os << ", \"hw\": {";
+			const char* separator = "";
+			for(unsigned j = 0; j < PerfCounters::NUM; ++j) {
+				if(!perf->available(static_cast<HwCounter>(j))) {continue;}
+				os << separator << "\"" << PerfCounters::name(static_cast<HwCounter>(j)) << "\": " << r.hw[j];
+				separator = ", ";
+			}
+			const auto cycles = r.hw[static_cast<unsigned>(HwCounter::CYCLES)];
+			if(perf->available(HwCounter::CYCLES) && perf->available(HwCounter::INSTRUCTIONS) && cycles > 0) {
+				os << ", \"ipc\": " << static_cast<double>(r.hw[static_cast<unsigned>(HwCounter::INSTRUCTIONS)]) / cycles;
+			}
+			os << "}";
+		}
+		os << "}"
+		   << ((i + 1 < reports.size()) ? ",\n" : "\n");
+	}
+	os << "  ],\n"
+	   << "  \"total\": {\"wall\": " << total.wall << ", \"cpu\": " << total.cpu << "},\n";
+	if(statistics != nullptr) {
+		os << "  \"statistics\": ";
+		statistics->writeJSON(os);
+		os << ",\n";
+	}
+	os << "  \"max_rss_kb\": " << maxRSS << "\n"
+	   << "}\n";
+}
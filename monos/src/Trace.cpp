@@ -0,0 +1,44 @@
+/* monos is written in C++.  It computes the weighted straight skeleton
+ * of a monotone polygon in asymptotic n log n time and linear space.
+ *
+ * Copyright 2018, 2019 Günther Eder - geder@cs.sbg.ac.at
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+
+#include "Trace.h"
+
+namespace trace {
+
+Ring ring;
+
+bool Ring::dump(const std::string& fileName) const {
+	std::ofstream out(fileName,std::ofstream::binary);
+	if(!out) {return false;}
+
+	const uint64_t recorded = head.load(std::memory_order_acquire);
+	const uint64_t stored   = (recorded < SIZE) ? recorded : SIZE;
+
+	Header header = {{'M','O','N','O','S','T','R','C'},1,sizeof(Record),recorded,stored};
+	out.write(reinterpret_cast<const char*>(&header),sizeof(header));
+
+	for(uint64_t i = recorded - stored; i < recorded; ++i) {
+		out.write(reinterpret_cast<const char*>(&records[i & (SIZE - 1)]),sizeof(Record));
+	}
+	return out.good();
+}
+
+}
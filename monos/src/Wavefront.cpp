@@ -20,21 +20,25 @@
 
 #include "cgTypes.h"
 #include "Wavefront.h"
+#include "Trace.h"
 
 void Wavefront::InitializeEventsAndPathsPerEdge() {
 	/* set up empty events for every edge;
 	* set up initial target node for pathfinder
 	**/
-	events.resize(data.getPolygon().size(),Event());
+	events.resize(data.getPolygon().size());
+	pathFinder.reserve(data.getPolygon().size());
 	for(const auto& e : data.getPolygon()) {
 		pathFinder.emplace_back(EndNodes(e.u, e.v));
 	}
-	for(unsigned long i = 0; i < data.getPolygon().size(); ++i) {
-		events[i].mainEdge = i;
-	}
 }
 
 void Wavefront::InitializeNodes() {
+	/* nodes and arcs of the chain skeletons and the merge stay well below
+	 * 3n, reserving keeps them from leaving stale copies in the arena */
+	nodes.reserve(3 * data.getVertices().size());
+	arcList.reserve(3 * data.getVertices().size());
+
 	/* create all terminal nodes of skeleton (vertices of input) */
 	for(const auto& v : data.getVertices()) {
 		addNode(v.p, 0, NodeType::TERMINAL);
@@ -52,7 +56,10 @@ bool Wavefront::ComputeSkeleton(ChainType type) {
 	/************************************/
 	/* 	filling the priority queue 		*/
 	/************************************/
-	if(!InitSkeletonQueue(chain)) {return false;}
+	{
+		Timings::Scope phase(data.timings,Phase::INIT_QUEUE);
+		if(!InitSkeletonQueue(chain)) {return false;}
+	}
 
 
 	/*********************************************/
@@ -85,34 +92,27 @@ bool Wavefront::InitSkeletonQueue(Chain& chain) {
 	 **/
 	if(chain.size() < 2) {return true;}
 
-	auto chainIterator = chain.begin();
 	/* first edge defines an unbounded face in the skeleton induced graph */
-	ul aEdgeIdx = *chainIterator;
-	++chainIterator;
-	ul bEdgeIdx = *chainIterator;
-	ChainRef it = ChainRef(chainIterator);
-	++chainIterator;
-	ul cEdgeIdx = *chainIterator;
+	ul aEdgeIdx = chain.front();
+	ul bEdgeIdx = chain.next(aEdgeIdx);
+	ul cEdgeIdx = chain.next(bEdgeIdx);
 
 	/************************************/
 	/* 	filling the priority queue 		*/
 	/************************************/
-	do {
-		cEdgeIdx = *chainIterator;
+	while(cEdgeIdx != MAX) {
 		/* create Event and add it to the queue */
-		auto event = getEdgeEvent(aEdgeIdx,bEdgeIdx,cEdgeIdx,it);
+		events.set(getEdgeEvent(aEdgeIdx,bEdgeIdx,cEdgeIdx));
 
-		events[event.mainEdge] = event;
-
-		/* iterate over the chainIterator */
-		it = chainIterator;
-		++chainIterator;
+		/* iterate along the chain */
 		aEdgeIdx = bEdgeIdx;
 		bEdgeIdx = cEdgeIdx;
-	} while(chainIterator != chain.end());
+		cEdgeIdx = chain.next(cEdgeIdx);
+	}
 
 	LOG(INFO) << "number of events " << events.size();
-	eventTimes = new EventQueue(&events, chain);
+	delete eventTimes;
+	eventTimes = new EventQueue(&events, chain, &data.arena, &data.statistics);
 
 	currentTime = 0;
 
@@ -120,33 +120,37 @@ bool Wavefront::InitSkeletonQueue(Chain& chain) {
 }
 
 bool Wavefront::SingleDequeue(Chain& chain) {
-	LOG(INFO) << std::endl << "########################### SingleDequeue ("<< eventTimes->size() << ") ##############################";
 
 	if(!eventTimes->empty()) {
 
-		const Event* e = eventTimes->peak()->priority.e;
-		ul edgeIdx = e->mainEdge;
+		ul edgeIdx = eventTimes->peak()->priority.edgeIdx;
+
+		/* a bounded wavefront stops at its limit, later events stay queued */
+		if(bounded && events.time(edgeIdx) > maxTime) {return false;}
+
+		TRACE(EVENTS, DEQUEUE, edgeIdx, eventTimes->size(), CGAL::to_double(events.time(edgeIdx)));
 		eventTimes->drop_by_tidx(edgeIdx);
 
-		if(currentTime <= e->eventTime && e->isEvent()) {
-			currentTime = e->eventTime;
+		if(currentTime <= events.time(edgeIdx) && events.isEvent(edgeIdx)) {
+			currentTime = events.time(edgeIdx);
 
-			if(eventTimes->empty() || eventTimes->peak()->priority.e->eventTime != currentTime) {
-				HandleSingleEdgeEvent(chain,e);
+			if(eventTimes->empty() || eventTimes->peak()->priority.time() != currentTime) {
+				HandleSingleEdgeEvent(chain,edgeIdx);
 			} else {
-				std::vector<const Event*> eventList = {e};
+				eventBatch.clear();
+				eventBatch.emplace_back(edgeIdx);
 
-				while(!eventTimes->empty() && eventTimes->peak()->priority.e->eventTime == currentTime) {
-					e = eventTimes->peak()->priority.e;
-					if(e->isEvent()) {
-						eventList.emplace_back(e);
+				while(!eventTimes->empty() && eventTimes->peak()->priority.time() == currentTime) {
+					edgeIdx = eventTimes->peak()->priority.edgeIdx;
+					if(events.isEvent(edgeIdx)) {
+						eventBatch.emplace_back(edgeIdx);
 					}
-					eventTimes->drop_by_tidx(e->mainEdge);
+					eventTimes->drop_by_tidx(edgeIdx);
 				}
-				HandleMultiEvent(chain,eventList);
+				HandleMultiEvent(chain,eventBatch);
 			}
 
-		} else if(e->eventTime == MAX) {
+		} else if(events.time(edgeIdx) == MAX) {
 			/* the remaining events in the queue have MAX time, thus, we are done! */
 			return false;
 		}
@@ -160,126 +164,127 @@ bool Wavefront::SingleDequeue(Chain& chain) {
 
 
 
-/* eventList holds all events with the same event time.
+/* eventList holds the edges of all events with the same event time.
  * -- on a single x-coordinate only a single event can take place, due to the
  *    monotonicity of the chain, thus we sort for unique 'x'-coordinate
  *    -- now for a single 'x' coordinate (at most) two events my occur, we have to
  *       choose the one closer to the chain
- * -- secondly we filter for real multi edge collapses, i.e., event points are equal */
-void Wavefront::HandleMultiEvent(Chain& chain, std::vector<const Event*> eventList) {
+ * -- secondly we filter for real multi edge collapses, i.e., event points are equal
+ * eventList is sorted by event point and reused for the single events in place,
+ * the multi edge collapses are collected in multiBatch, each closed by MAX */
+void Wavefront::HandleMultiEvent(Chain& chain, std::vector<ul>& eventList) {
 	if(eventList.size() == 1) {
 		HandleSingleEdgeEvent(chain,eventList[0]);
-	} else {
-		std::map<NT,const Event*> eventsPerXCoord;
-		std::map<Point,std::vector<const Event*>> multiEvents;
-
-		LOG(INFO) << "events:";
-		for(const auto* e : eventList) {
-
-			if(e->mainEdge == *(e->chainEdge))  {LOG(INFO) << "event is still true!";}
-
-			auto it = eventsPerXCoord.find(e->eventPoint.x());
-			if(it != eventsPerXCoord.end()) {
-				bool aAboveB = data.isAbove(e->eventPoint,it->second->eventPoint);
-				if(e->eventPoint == it->second->eventPoint) {
-					auto multiIt = multiEvents.find(e->eventPoint);
-					multiIt->second.emplace_back(e);
-					eventsPerXCoord.erase(it);
-				} else if( (  aAboveB  &&  !isLowerChain(chain)) ||
-						   ( !aAboveB  &&   isLowerChain(chain))) {
-					eventsPerXCoord.erase(it);
-					eventsPerXCoord.insert({e->eventPoint.x(),e});
-				}
-			} else {
-				eventsPerXCoord.insert({e->eventPoint.x(),e});
-				multiEvents.insert({e->eventPoint,{e}});
+		return;
+	}
+
+	std::sort(eventList.begin(),eventList.end(),[&](const ul& a, const ul& b) {
+		return events.point(a) < events.point(b);
+	});
+
+	multiBatch.clear();
+	ul numSingles = 0;
+
+	LOG(INFO) << "events:";
+	for(ul runBegin = 0, runEnd = 0; runBegin < eventList.size(); runBegin = runEnd) {
+		const NT& x = events.point(eventList[runBegin]).x();
+		ul single = MAX;
+
+		/* the run of one x splits into sub-runs of equal points, every one of
+		 * two or more events is a multi edge collapse of its own */
+		runEnd = runBegin;
+		while(runEnd < eventList.size() && events.point(eventList[runEnd]).x() == x) {
+			const ul subBegin = runEnd;
+			const Point& P = events.point(eventList[subBegin]);
+			while(runEnd < eventList.size() && events.point(eventList[runEnd]) == P) {++runEnd;}
+
+			if(runEnd - subBegin > 1) {
+				multiBatch.insert(multiBatch.end(),eventList.begin() + subBegin,eventList.begin() + runEnd);
+				multiBatch.emplace_back(MAX);
+			} else if(single == MAX || !isLowerChain(chain)) {
+				/* points are sorted by y as well, the lower chain takes the
+				 * lowest single event, the upper chain the upper most */
+				single = eventList[subBegin];
 			}
 		}
 
-		for(auto e : eventsPerXCoord) {
-			HandleSingleEdgeEvent(chain,e.second);
-		}
+		if(single != MAX) {eventList[numSingles++] = single;}
+	}
+	eventList.resize(numSingles);
 
-		for(auto l : multiEvents) {
-			if(l.second.size() > 1) {
-				HandleMultiEdgeEvent(chain,l.second);
-			}
+	for(auto e : eventList) {
+		HandleSingleEdgeEvent(chain,e);
+	}
+
+	multiEdgeEvent.clear();
+	for(auto e : multiBatch) {
+		if(e != MAX) {
+			multiEdgeEvent.emplace_back(e);
+		} else {
+			HandleMultiEdgeEvent(chain,multiEdgeEvent);
+			multiEdgeEvent.clear();
 		}
 	}
 }
 
-void Wavefront::HandleMultiEdgeEvent(Chain& chain, std::vector<const Event*> eventList) {
-	LOG(INFO) << "ME: HandleMultiEdgeEvent! (one point, multiple edge collapses)";
-
+void Wavefront::HandleMultiEdgeEvent(Chain& chain, const std::vector<ul>& eventList) {
 	auto anEvent = eventList[0];
-	auto nodeIdx = addNode(anEvent->eventPoint,anEvent->eventTime);
-	auto& node   = *getNode(nodeIdx);
 
 	/* add the single node, all arcs connect to this node */
-	LOG(INFO) << "adding node: " << node;
+	auto nodeIdx = addNode(events.point(anEvent),events.time(anEvent));
+	TRACE(EVENTS, MULTI_EVENT, nodeIdx, eventList.size(), CGAL::to_double(events.time(anEvent)));
+	++data.statistics.multiEvents;
+	data.statistics.multiEventEdges += eventList.size();
 
-	std::set<std::pair<ul,ul>> pairs;
+	edgePairs.clear();
 	for(auto event : eventList) {
-		std::vector<ul> va = {event->leftEdge,event->mainEdge },
-				        vb = {event->mainEdge,event->rightEdge};
-
-		for(auto v : { va, vb } ) {
-			pairs.insert({v[0],v[1]});
-		}
+		edgePairs.emplace_back(events.leftEdge(event),event);
+		edgePairs.emplace_back(event,events.rightEdge(event));
 	}
+	std::sort(edgePairs.begin(),edgePairs.end());
+	edgePairs.erase(std::unique(edgePairs.begin(),edgePairs.end()),edgePairs.end());
 
-	for(auto p : pairs) {
+	for(auto p : edgePairs) {
 		ul pIdx = pathFinder[p.first].b;
 		addArc(pIdx,nodeIdx,p.first,p.second);
 	}
 
 	for(auto event : eventList) {
 		/* update path finder for left and right edge */
-		pathFinder[event->leftEdge ].b = nodeIdx;
-		pathFinder[event->mainEdge ].a = nodeIdx;
-		pathFinder[event->mainEdge ].b = nodeIdx;
-		pathFinder[event->rightEdge].a = nodeIdx;
+		pathFinder[events.leftEdge(event) ].b = nodeIdx;
+		pathFinder[event                  ].a = nodeIdx;
+		pathFinder[event                  ].b = nodeIdx;
+		pathFinder[events.rightEdge(event)].a = nodeIdx;
 	}
 
-	auto chainIt = chain.begin();
+	/* the edge following the last removed edge */
+	ul nextIdx = MAX;
 
 	for(auto event : eventList) {
 		/* remove this edges from the chain (wavefront) */
-		chainIt = chain.erase(event->chainEdge);
-		disableEdge(event->mainEdge);
+		nextIdx = chain.next(event);
+		chain.erase(event);
+		disableEdge(event);
 	}
 
-	if(chainIt != chain.begin()) {
-		--chainIt;
-
-		auto idxA = *(--chainIt);
-		auto idxB = *(++chainIt);
-		auto idxC = *(++chainIt);
-		auto idxD = *(++chainIt);
-		--chainIt;
-		--chainIt;
-		ChainRef it1 = ChainRef(chainIt);
-		ChainRef it2 = ChainRef(++chainIt);
+	if(nextIdx != MAX && nextIdx != chain.front()) {
+		auto idxC = nextIdx;
+		auto idxB = chain.prev(idxC);
+		auto idxA = chain.prev(idxB);
+		auto idxD = chain.next(idxC);
 
 		if(idxA != idxB && idxB != idxC && idxC != idxD) {
-			/**/
-			LOG(INFO) << "TODO: only reference and add arcs if we are not before/after the chain ends!";
-
 			/* only if in current chain! */
 			pathFinder[idxB].b = nodeIdx;
 			pathFinder[idxC].a = nodeIdx;
 
-			auto e1 = getEdgeEvent(idxA,idxB,idxC,it1);
-			auto e2 = getEdgeEvent(idxB,idxC,idxD,it2);
-
-			LOG(INFO) << "indices A,B,C,D: " << idxA << " " << idxB << " " << idxC << " " << idxD;
-			LOG(INFO) << e1;
-			LOG(INFO) << e2;
-
+			/* only reference and add events if we are not before/after the chain ends */
 			if(idxB != chain.front()) {
+				auto e1 = getEdgeEvent(idxA,idxB,idxC);
 				updateInsertEvent(e1);
 			}
 			if(idxC != chain.back()) {
+				auto e2 = getEdgeEvent(idxB,idxC,idxD);
 				updateInsertEvent(e2);
 			}
 		} else {
@@ -290,18 +295,19 @@ void Wavefront::HandleMultiEdgeEvent(Chain& chain, std::vector<const Event*> eve
 	}
 }
 
-void Wavefront::HandleSingleEdgeEvent(Chain& chain,  const Event* event) {
-	LOG(INFO) << "SE: " << *event;
+void Wavefront::HandleSingleEdgeEvent(Chain& chain, const ul& edgeIdx) {
+	TRACE(EVENTS, SINGLE_EVENT, edgeIdx, 0, CGAL::to_double(events.time(edgeIdx)));
+	++data.statistics.singleEvents;
 	/* build skeleton from event */
-	addNewNodefromEvent(*event);
+	addNewNodefromEvent(edgeIdx);
 
 	/* check neighbours for new events, and back into the queue */
 	/* edges B,C are the two edges left, right of the event edge,
 	 * A,D their respective neighbours */
-	updateNeighborEdgeEvents(*event,chain);
+	updateNeighborEdgeEvents(edgeIdx,chain);
 
 	/* remove this edge from the chain (wavefront) */
-	chain.erase(event->chainEdge);
+	chain.erase(edgeIdx);
 }
 
 bool Wavefront::FinishSkeleton(Chain& chain) {
@@ -312,16 +318,15 @@ bool Wavefront::FinishSkeleton(Chain& chain) {
 	Point pCheck;
 
 	ul aEdgeIdx, bEdgeIdx;
-	auto chainIterator = chain.begin();
 	/***********************************************************************/
 	/* construct rays from remaining edges in chain, i.e,. unbounded faces */
 	/***********************************************************************/
 	if(chain.size() > 1) {
 		LOG(INFO) << " ------------------ FINISH SKELETON ------------------";
-		chainIterator = chain.begin();
-		aEdgeIdx = *chainIterator; ++chainIterator;
+		if(bounded && frontRays.empty()) {frontRays.resize(data.getPolygon().size(),MAX);}
+		aEdgeIdx = chain.front();
+		bEdgeIdx = chain.next(aEdgeIdx);
 		do {
-			bEdgeIdx = *chainIterator;
 			LOG(INFO) << "chain edges: " <<  aEdgeIdx << ", " << bEdgeIdx;
 			/* last node on path of both edges must be the same, get that node */
 			auto endNodeIdx = pathFinder[aEdgeIdx].b;
@@ -335,39 +340,32 @@ bool Wavefront::FinishSkeleton(Chain& chain) {
 			pCheck = la.point(0) + bisSimple.to_vector();
 			if(!la.has_on_positive_side(pCheck)) {bisSimple = bisSimple.opposite();}
 
-			addArcRay(endNodeIdx,aEdgeIdx,bEdgeIdx,Ray(node->point,bisSimple.direction()));
+			ul rayIdx = addArcRay(endNodeIdx,aEdgeIdx,bEdgeIdx,Ray(node->point,bisSimple.direction()));
+			if(bounded) {frontRays[aEdgeIdx] = rayIdx;}
 
 			/* iterate over remaining chain */
 			aEdgeIdx = bEdgeIdx;
-		} while(++chainIterator != chain.end());
+			bEdgeIdx = chain.next(bEdgeIdx);
+		} while(bEdgeIdx != MAX);
 	}
 
 	return true;
 }
 
-void Wavefront::updateNeighborEdgeEvents(const Event& event, const Chain& chain) {
+void Wavefront::updateNeighborEdgeEvents(const ul& edgeIdx, const Chain& chain) {
 	ul edgeA, edgeB, edgeC, edgeD;
-	edgeB = event.leftEdge;
-	edgeC = event.rightEdge;
-	LOG(INFO) << event;
-	ChainRef it(event.chainEdge);
-	--it;
-
-	if(*it == edgeB && edgeB != chain.front()) {
-		--it;		edgeA = *it;
+	edgeB = events.leftEdge(edgeIdx);
+	edgeC = events.rightEdge(edgeIdx);
 
-		it = ChainRef(event.chainEdge); --it;
-		auto neighborEvent = getEdgeEvent(edgeA,edgeB,edgeC,it);
+	if(chain.prev(edgeIdx) == edgeB && edgeB != chain.front()) {
+		edgeA = chain.prev(edgeB);
+		auto neighborEvent = getEdgeEvent(edgeA,edgeB,edgeC);
 		updateInsertEvent(neighborEvent);
 	}
 
-	it = ChainRef(event.chainEdge);
-	++it;
-	if(*it == edgeC && edgeC != chain.back()) {
-		++it;		edgeD = *it;
-
-		it = ChainRef(event.chainEdge); ++it;
-		auto neighborEvent = getEdgeEvent(edgeB,edgeC,edgeD,it);
+	if(chain.next(edgeIdx) == edgeC && edgeC != chain.back()) {
+		edgeD = chain.next(edgeC);
+		auto neighborEvent = getEdgeEvent(edgeB,edgeC,edgeD);
 		updateInsertEvent(neighborEvent);
 	}
 }
@@ -376,40 +374,41 @@ void Wavefront::updateInsertEvent(Event& event) {
 	/* check if edge has already an event in the queue */
 
 	if(event.eventTime < currentTime) {
-		event.eventTime = MAX;
-		event.eventPoint = INFPOINT;
-		LOG(INFO) << "!! we set " << event.mainEdge << " to MAX!";
+		TRACE(EVENTS, EVENT_DISCARDED, event.mainEdge, 0, CGAL::to_double(event.eventTime));
+		++data.statistics.staleEvents;
+		/* the neighbours of a disabled event are never read */
+		events.setTime(event.mainEdge,MAX);
+		events.setPoint(event.mainEdge,INFPOINT);
+	} else {
+		events.setTime(event.mainEdge,std::move(event.eventTime));
+		events.setPoint(event.mainEdge,std::move(event.eventPoint));
+		events.setNeighbours(event.mainEdge,event.leftEdge,event.rightEdge);
 	}
-
-	events[event.mainEdge] = event;
 	eventTimes->update_by_tidx(event.mainEdge);
 }
 
-Event Wavefront::getEdgeEvent(const ul& aIdx, const ul& bIdx, const ul& cIdx, const ChainRef& it) const {
+Event Wavefront::getEdgeEvent(const ul& aIdx, const ul& bIdx, const ul& cIdx) const {
 	const Line& a = data.get_line(aIdx);
 	const Line& b = data.get_line(bIdx);
 	const Line& c = data.get_line(cIdx);
 
-	LOG(INFO) << "get event " << aIdx << "," << bIdx << "," << cIdx;
-
 	/* compute bisector from edges */
 	/* lets first test if this is too expexive */
 	auto abBisL = (a != b) ? data.simpleBisector(a,b) : getNormalBisector(aIdx,bIdx,b);
 	auto bcBisL = (b != c) ? data.simpleBisector(b,c) : getNormalBisector(bIdx,cIdx,b);
 
-	LOG(INFO) << "AB is collinear: " << isCollinear(a,b) << " -- BC is collinear: " << isCollinear(b,c);;
-
 	auto intersectionSimple = intersectElements(abBisL, bcBisL);
 	if( intersectionSimple != INFPOINT && b.has_on_positive_side(intersectionSimple) ) {
 		auto distance = normalDistance(b, intersectionSimple);
 		/* does collapse so we create an event
 		 * and add it to the queue
 		 **/
-		LOG(INFO) << "YES ofr " << aIdx << "," << bIdx << "," << cIdx << " at " << intersectionSimple << " with dist: " << distance;
-		return Event(distance,intersectionSimple,aIdx,bIdx,cIdx,it);
+		TRACE(EVENTS, EDGE_EVENT, bIdx, 1, CGAL::to_double(distance));
+		return Event(distance,intersectionSimple,aIdx,bIdx,cIdx);
 	}
 
-	return Event(MAX,INFPOINT,aIdx,bIdx,cIdx,it);
+	TRACE(EVENTS, EDGE_EVENT, bIdx, 0);
+	return Event(MAX,INFPOINT,aIdx,bIdx,cIdx);
 }
 
 
@@ -417,15 +416,15 @@ void Wavefront::ChainDecomposition() {
 	/* assuming CCW orientation of polygon */
 	auto edgeIt = data.findEdgeWithVertex(data.bbox->monMin);
 
-	lowerChain.emplace_back(edgeIt->id);
+	lowerChain.push_back(edgeIt->id);
 	do {
 		edgeIt = data.cNext(edgeIt);
-		lowerChain.emplace_back(edgeIt->id);
+		lowerChain.push_back(edgeIt->id);
 	} while(!edgeIt->has(data.bbox->monMax.id));
 
 	do {
 		edgeIt = data.cNext(edgeIt);
-		upperChain.emplace_back(edgeIt->id);
+		upperChain.push_back(edgeIt->id);
 	} while(!edgeIt->has(data.bbox->monMin.id));
 
 }
@@ -434,20 +433,18 @@ ul Wavefront::addArcRay(const ul& nodeAIdx, const ul& edgeLeft, const ul& edgeRi
 	auto& nodeA = nodes[nodeAIdx];
 	auto arcIdx = arcList.size();
 
-	const Segment seg = restrictRay(ray);
-
 	arcList.emplace_back(Arc(
 			ArcType::RAY,
 			nodeAIdx,
 			MAX,
 			edgeLeft,
 			edgeRight,
-			arcList.size(),
-			seg
+			arcList.size()
 	));
+	rayTargets.emplace_back(restrictRay(nodeA.point,ray.direction()));
 
 	nodeA.arcs.emplace_back(arcIdx);
-	LOG(INFO) << "+/ adding ray: " << arcIdx << " -- " << arcList.back();
+	TRACE(EVENTS, ADD_RAY, arcIdx, nodeAIdx);
 	return arcIdx;
 }
 
@@ -461,24 +458,25 @@ ul Wavefront::addArc(const ul& nodeAIdx, const ul& nodeBIdx, const ul& edgeLeft,
 			nodeBIdx,
 			edgeLeft,
 			edgeRight,
-			arcList.size(),
-			Segment(nodeA.point, nodeB.point)
+			arcList.size()
 	));
+	rayTargets.emplace_back(INFPOINT);
 	nodeA.arcs.emplace_back(arcIdx);
 	nodeB.arcs.emplace_back(arcIdx);
-	LOG(INFO) << "++ adding arc: " << arcIdx;
+	TRACE(EVENTS, ADD_ARC, arcIdx, nodeAIdx);
 	return arcIdx;
 }
 
 Arc* Wavefront::getRightmostArcEndingAtNode(const Node& node, Arc *currentArc) {
 	Arc *ret = currentArc;
-	NT x = currentArc->point(0).x();
+	NT x = getArcSource(*currentArc).x();
 	for(auto arcIdx : node.arcs) {
 		if(arcIdx == currentArc->id) {continue;}
 		Arc* arc = getArc(arcIdx);
 		if(arc->secondNodeIdx == node.id) {
-			if(x < arc->point(0).x()) {
-				x = arc->point(0).x();
+			const Point& P = getArcSource(*arc);
+			if(x < P.x()) {
+				x = P.x();
 				ret = arc;
 			}
 		}
@@ -487,37 +485,38 @@ Arc* Wavefront::getRightmostArcEndingAtNode(const Node& node, Arc *currentArc) {
 }
 
 Arc* Wavefront::findRightmostArcFromNodeWithY(const Node& node, const NT& y) {
-	Node nodeIt = node;
+	/* by pointer, a copy of the node would copy its arcs as well */
+	const Node* nodeIt = &node;
 	bool searchUpwards = (node.point.y() < y);
 	LOG(INFO) << "---(ghost hunt) search up: " << searchUpwards;
 	while(true) {
-		ul nodeIdxIt = nodeIt.id;
-		nodeIt = nodes[nodeIdxIt];
-		const Point& NP = nodeIt.point;
+		ul nodeIdxIt = nodeIt->id;
+		nodeIt = &nodes[nodeIdxIt];
+		const Point& NP = nodeIt->point;
 
 		ul arcIdxIt  = MAX;
 		NT x = -MAX;
 
-		LOG(INFO) << "looking at node " << nodeIt;
+		LOG(INFO) << "looking at node " << *nodeIt;
 
-		for(auto arcIdx : nodeIt.arcs) {
+		for(auto arcIdx : nodeIt->arcs) {
 			auto arc = getArc(arcIdx);
-			const Point& P = (arc->point(0) == NP) ? arc->point(1) : arc->point(0);
+			const Point P = (getArcSource(*arc) == NP) ? getArcTarget(*arc) : getArcSource(*arc);
 			if((x < P.x())
 				&&
 				( (searchUpwards && P.y() > NP.y()) || (!searchUpwards && P.y() < NP.y()) )
 			) {
 				x = P.x();
 				arcIdxIt = arcIdx;
-				nodeIdxIt = (arc->firstNodeIdx != nodeIt.id) ? arc->firstNodeIdx :  arc->secondNodeIdx;
+				nodeIdxIt = (arc->firstNodeIdx != nodeIt->id) ? arc->firstNodeIdx :  arc->secondNodeIdx;
 			}
 		}
 
 		auto currentArc = getArc(arcIdxIt);
-		if(currentArc->has_on_y(y)) {
+		if(arcHasOnY(*currentArc,y)) {
 			return currentArc;
 		} else {
-			if(currentArc->isRay() || nodeIt.arcs.size() == 1) {
+			if(currentArc->isRay() || nodeIt->arcs.size() == 1) {
 				break;
 			}
 		}
@@ -536,66 +535,71 @@ ul Wavefront::getOutgoingArc(const Node& node) {
 }
 
 
-Segment Wavefront::restrictRay(const Ray& ray) {
-	Point Pa = ray.source();
-	Point Pb;
+bool Wavefront::arcHasOnY(const Arc& arc, const NT& y) const {
+	const NT& ya = getArcSource(arc).y();
+	const NT& yb = getArcTarget(arc).y();
+	return (ya < y && yb > y) || (ya > y && yb < y);
+}
 
-	if(state == STATE::UPPER) {
+/* rays of the upper chain point downwards, rays of the lower chain upwards,
+ * we restrict them to the bounding box in that direction */
+Point Wavefront::restrictRay(const Point& Pa, const Direction& dir) const {
+	if(dir.dy() < 0) {
 		if(data.bbox->yMin.p.y() > Pa.y()) {
-			Pb = Pa;
+			return Pa;
 		} else {
-			NT Pb_x = ray.supporting_line().x_at_y(data.bbox->yMin.p.y());
-			Pb = Point(Pb_x,data.bbox->yMin.p.y());
+			NT Pb_x = Line(Pa,dir).x_at_y(data.bbox->yMin.p.y());
+			return Point(Pb_x,data.bbox->yMin.p.y());
 		}
 	} else {
 		if(data.bbox->yMax.p.y() < Pa.y()) {
-			Pb = Pa;
+			return Pa;
 		} else {
-			NT Pb_x = ray.supporting_line().x_at_y(data.bbox->yMax.p.y());
-			Pb = Point(Pb_x,data.bbox->yMax.p.y());
+			NT Pb_x = Line(Pa,dir).x_at_y(data.bbox->yMax.p.y());
+			return Point(Pb_x,data.bbox->yMax.p.y());
 		}
 	}
-
-	return Segment(ray.source(),Pb);
 }
 
-void Wavefront::addNewNodefromEvent(const Event& event) {
+void Wavefront::addNewNodefromEvent(const ul& edgeIdx) {
 	ul nodeIdx  = nodes.size();
-	auto& paths = pathFinder[event.mainEdge];
+	auto& paths = pathFinder[edgeIdx];
+	const Point& P  = events.point(edgeIdx);
+	const ul leftEdge  = events.leftEdge(edgeIdx);
+	const ul rightEdge = events.rightEdge(edgeIdx);
 
 	Point& Pa = getNode(paths.a)->point; Point& Pb = getNode(paths.b)->point;
 
 	/* if this is already done, i.e., left and/or right path ends at a node of the event */
-	if( Pa != event.eventPoint && Pb != event.eventPoint ) {
+	if( Pa != P && Pb != P ) {
 		/* a classical event to be handled */
-		LOG(INFO) << "event point before adding node " << event.eventPoint;
-		nodeIdx = addNode(event.eventPoint,event.eventTime);
+		nodeIdx = addNode(P,events.time(edgeIdx));
 
-		addArc(paths.a,nodeIdx,event.leftEdge,event.mainEdge);
-		addArc(paths.b,nodeIdx,event.mainEdge,event.rightEdge);
+		addArc(paths.a,nodeIdx,leftEdge,edgeIdx);
+		addArc(paths.b,nodeIdx,edgeIdx,rightEdge);
 
 	} else {
 		/* at least one point is equal */
 
-		bool aEqual = (Pa == event.eventPoint);
-		bool bEqual = (Pb == event.eventPoint);
+		bool aEqual = (Pa == P);
+		bool bEqual = (Pb == P);
 
 		if(aEqual && bEqual) {
 			nodeIdx = paths.a;
 		} else if(aEqual) {
 			/* so we use the left referenced node and only create a new arc for the right side */
 			nodeIdx = paths.a;
-			addArc(paths.b,nodeIdx,event.mainEdge,event.rightEdge);
+			addArc(paths.b,nodeIdx,edgeIdx,rightEdge);
 		} else if(bEqual) {
 			/* so we use the left referenced node and only create a new arc for the left side */
 			nodeIdx = paths.b;
-			addArc(paths.a,nodeIdx,event.leftEdge,event.mainEdge);
+			addArc(paths.a,nodeIdx,leftEdge,edgeIdx);
 		}
 	}
 
 	/* update path finder for left and right edge */
-	pathFinder[event.leftEdge].b  = nodeIdx;
-	pathFinder[event.rightEdge].a = nodeIdx;
+	pathFinder[leftEdge].b  = nodeIdx;
+	pathFinder[rightEdge].a = nodeIdx;
 }
 
 ul Wavefront::getNextArcIdx(const ul& path, bool forward, ul edgeIdx) {
@@ -625,6 +629,71 @@ ul Wavefront::getNextArcIdx(const ul& path, bool forward, ul edgeIdx) {
 }
 
 
+/* drop the disabled arcs and the nodes no remaining arc references, renumber
+ * the rest in their current order and rewrite all references to them;
+ * the terminal nodes are kept, thus node i remains the node of vertex i */
+void Wavefront::compact() {
+	std::vector<ul> nodeMap(nodes.size(),MAX), arcMap(arcList.size(),MAX);
+
+	for(ul i = 0; i < data.getVertices().size(); ++i) {
+		nodeMap[i] = 0;
+	}
+
+	ul numArcs = 0;
+	for(ul i = 0; i < arcList.size(); ++i) {
+		const auto& arc = arcList[i];
+		if(arc.isDisable()) {continue;}
+		arcMap[i] = numArcs++;
+		nodeMap[arc.firstNodeIdx] = 0;
+		if(arc.secondNodeIdx != MAX) {nodeMap[arc.secondNodeIdx] = 0;}
+	}
+
+	ul numNodes = 0;
+	for(auto& idx : nodeMap) {
+		if(idx != MAX) {idx = numNodes++;}
+	}
+
+	data.statistics.disabledArcs += arcList.size() - numArcs;
+
+	LOG(INFO) << "compaction: nodes " << nodes.size() << " -> " << numNodes
+			  << ", arcs " << arcList.size() << " -> " << numArcs;
+
+	/* move the remaining elements to the front, the new index is never
+	 * larger than the old one, hence no element is overwritten too early */
+	for(ul i = 0; i < nodes.size(); ++i) {
+		if(nodeMap[i] == MAX) {continue;}
+		if(nodeMap[i] != i) {nodes[nodeMap[i]] = std::move(nodes[i]);}
+
+		auto& node = nodes[nodeMap[i]];
+		node.id = nodeMap[i];
+		node.arcs.erase(std::remove_if(node.arcs.begin(),node.arcs.end(),
+				[&](const ul& a) {return arcMap[a] == MAX;}), node.arcs.end());
+		for(auto& a : node.arcs) {a = arcMap[a];}
+	}
+	nodes.erase(nodes.begin() + numNodes, nodes.end());
+
+	for(ul i = 0; i < arcList.size(); ++i) {
+		if(arcMap[i] == MAX) {continue;}
+		if(arcMap[i] != i) {arcList[arcMap[i]] = arcList[i];}
+
+		auto& arc = arcList[arcMap[i]];
+		arc.id = arcMap[i];
+		arc.firstNodeIdx = nodeMap[arc.firstNodeIdx];
+		if(arc.secondNodeIdx != MAX) {arc.secondNodeIdx = nodeMap[arc.secondNodeIdx];}
+	}
+	arcList.erase(arcList.begin() + numArcs, arcList.end());
+
+	for(ul i = 0; i < rayTargets.size(); ++i) {
+		if(arcMap[i] != MAX && arcMap[i] != i) {rayTargets[arcMap[i]] = rayTargets[i];}
+	}
+	rayTargets.erase(rayTargets.begin() + numArcs, rayTargets.end());
+
+	for(auto& p : pathFinder) {
+		p.a = (p.a != NIL && nodeMap[p.a] != MAX) ? nodeMap[p.a] : NIL;
+		p.b = (p.b != NIL && nodeMap[p.b] != MAX) ? nodeMap[p.b] : NIL;
+	}
+}
+
 void Wavefront::printChain(const Chain& chain) const {
 	std::stringstream ss;
 	ss <<  "chain links: ";
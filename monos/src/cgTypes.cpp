@@ -75,8 +75,6 @@ std::ostream& operator<< (std::ostream& os, const Event& event) {
     		<< event.leftEdge << ","
 			<< event.mainEdge << ","
 			<< event.rightEdge << "]";
-    auto it1 = ChainRef(event.chainEdge);
-    os << " it(" << *(--it1) << "," << *(++it1) << "," << *(++it1) << ")";
     return os;
 }
 
@@ -98,11 +96,6 @@ std::ostream& operator<< (std::ostream& os, const Arc& arc) {
     case ArcType::RAY : os << " ray"; break; 		//: " << arc.ray; break;
     case ArcType::NORMAL : os << " edge"; break; 	//: " << arc.edge; break;
     }
-    if(arc.is_vertical()) {
-    	os << " -v- ";
-    } else if(arc.is_horizontal()) {
-    	os << " -h- ";
-    }
     return os;
 }
 